@@ -0,0 +1,39 @@
+#!/bin/sh
+# ============================================================================
+# Name        : bench_grounded.sh
+# Author      : Matthias Thimm
+# Version     : 1.0
+# Copyright   : GPL3
+# Description : benchmark for the computation of the grounded extension on
+#               large chains (argument i attacks i+1) and trees (argument i
+#               attacks its parent i/2, so leaves attack their parents);
+#               the frameworks are generated in ICCMA23 format, converted
+#               into snapshots, and SE-GR is timed on the snapshots
+# ============================================================================
+#
+# usage: bench_grounded.sh [taas-fudge binary] [working directory]
+
+BIN=${1:-./taas-fudge}
+DIR=${2:-/tmp/taas-bench-grounded}
+mkdir -p "$DIR" || exit 1
+
+# generates a chain with $1 arguments
+chain(){
+  awk -v n="$1" 'BEGIN{ print "p af " n; for(i = 1; i < n; i++) print i, i+1 }'
+}
+
+# generates a binary tree with $1 arguments whose leaves attack their parents
+tree(){
+  awk -v n="$1" 'BEGIN{ print "p af " n; for(i = 2; i <= n; i++) print i, int(i/2) }'
+}
+
+for inst in chain:1000000 tree:25000 tree:50000 tree:100000 tree:1000000; do
+  kind=${inst%%:*}
+  n=${inst#*:}
+  file="$DIR/${kind}_$n"
+  [ -f "$file.bin" ] || { $kind "$n" > "$file.i23" && "$BIN" -f "$file.i23" -snapshot "$file.bin" > /dev/null; } || exit 1
+  start=$(date +%s.%N)
+  "$BIN" -p SE-GR -f "$file.bin" -fo bin > /dev/null
+  end=$(date +%s.%N)
+  awk -v k="$kind" -v n="$n" -v s="$start" -v e="$end" 'BEGIN{ printf "%s %d: %.2fs\n", k, n, e - s }'
+done
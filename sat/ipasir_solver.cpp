@@ -18,9 +18,24 @@
 
 
 struct IpasirSolver{
-    void* theSolver = ipasir_init();
+    void* theSolver = NULL;
+    // if set, clauses are recorded there (each terminated by 0) instead of
+    // being added to the solver (cf. sat__record())
+    std::vector<int>* cnf = NULL;
 };
 
+// makes the given solver record clauses instead of solving them
+void sat__record(IpasirSolver & solver, std::vector<int>* cnf){
+   solver.cnf = cnf;
+}
+
+// adds a literal to the solver or records it
+inline void sat__push(IpasirSolver & solver, int lit){
+    if(solver.cnf != NULL)
+        solver.cnf->push_back(lit);
+    else ipasir_add(solver.theSolver, lit);
+}
+
 // inits a new solver with a new set of variables
 void sat__init(IpasirSolver & solver, int num_vars){
    solver.theSolver = ipasir_init();
@@ -28,7 +43,7 @@ void sat__init(IpasirSolver & solver, int num_vars){
 
 // adds a literal (clause must be terminated by 0)
 void sat__add(IpasirSolver & solver, int var){
-    ipasir_add(solver.theSolver, var);
+    sat__push(solver, var);
 }
 
 // assume literal
@@ -38,42 +53,42 @@ void sat__assume(IpasirSolver & solver, int lit){
 
 // adds clauses
 void sat__addClause1(IpasirSolver & solver, int var){
-    ipasir_add(solver.theSolver, var);
-    ipasir_add(solver.theSolver, 0);
+    sat__push(solver, var);
+    sat__push(solver, 0);
 }
 
 // adds clauses
 void sat__addClause2(IpasirSolver & solver, int var1, int var2){
-    ipasir_add(solver.theSolver, var1);
-    ipasir_add(solver.theSolver, var2);
-    ipasir_add(solver.theSolver, 0);
+    sat__push(solver, var1);
+    sat__push(solver, var2);
+    sat__push(solver, 0);
 }
 
 // adds clauses
 void sat__addClause3(IpasirSolver & solver, int var1, int var2, int var3){
-    ipasir_add(solver.theSolver, var1);
-    ipasir_add(solver.theSolver, var2);
-    ipasir_add(solver.theSolver, var3);
-    ipasir_add(solver.theSolver, 0);
+    sat__push(solver, var1);
+    sat__push(solver, var2);
+    sat__push(solver, var3);
+    sat__push(solver, 0);
 }
 
 // adds clauses
 void sat__addClause(IpasirSolver & solver, int* clause, int num){
     for(int i = 0; i < num; i++)
-        ipasir_add(solver.theSolver, clause[i]);
-    ipasir_add(solver.theSolver, 0);
+        sat__push(solver, clause[i]);
+    sat__push(solver, 0);
 }
 
 void sat__addClauseZTVec(IpasirSolver & solver, std::vector<int> clause){
     for(int i = 0; i < clause.size(); i++)
-        ipasir_add(solver.theSolver, clause[i]);
+        sat__push(solver, clause[i]);
 }
 
 // adds clauses
 void sat__addClauseZT(IpasirSolver & solver, int* clause){
   int i = 0;
   do{
-      ipasir_add(solver.theSolver,clause[i]);
+      sat__push(solver, clause[i]);
   }while(clause[i++] != 0);
 }
 
@@ -89,7 +104,49 @@ int sat__get(IpasirSolver & solver, int var){
 
 // free memory
 void sat__free(IpasirSolver & solver){
-  free(solver.theSolver);
+  ipasir_release(solver.theSolver);
+  solver.theSolver = NULL;
+}
+
+/**
+ * Enumerates the models of the given solver projected onto the given
+ * variables without blocking clauses, and calls visit() after each one
+ * (until it returns FALSE). The projections form a binary tree over the
+ * variables in the given order; each model found below a prefix of
+ * assumed literals is a leaf of the subtree of the prefix, whose other
+ * leaves are in the subtrees where the model is followed up to some
+ * position and the literal there is flipped. These subtrees are searched
+ * depth-first (the deepest first), so only the current literals and a
+ * stack of positions are kept, and each call of the solver gets a new
+ * projection or fails on a flipped literal. Returns FALSE iff visit()
+ * stopped the enumeration.
+ */
+template<typename F> int sat__enumerate(IpasirSolver & solver, std::vector<int>& vars, F visit){
+  int k = vars.size();
+  // the current literals of the variables; the first depth ones are assumed
+  std::vector<int> lits(k);
+  // for each model found, the position it was found at (bottom) and the
+  // next position to flip (the subtrees at positions >= top are searched)
+  std::vector<std::pair<int,int> > stack;
+  int depth = 0;
+  while(true){
+    for(int j = 0; j < depth; j++)
+      sat__assume(solver,lits[j]);
+    if(sat__solve(solver) == 10){
+      for(int j = depth; j < k; j++)
+        lits[j] = sat__get(solver,vars[j]) > 0 ? vars[j] : -vars[j];
+      if(!visit())
+        return FALSE;
+      stack.push_back(std::make_pair(depth,k));
+    }
+    while(!stack.empty() && stack.back().second == stack.back().first)
+      stack.pop_back();
+    if(stack.empty())
+      return TRUE;
+    int j = --stack.back().second;
+    lits[j] = -lits[j];
+    depth = j+1;
+  }
 }
 
 /** prints the clause */
@@ -102,9 +159,9 @@ void printClause(int* clause, int num, int* in_vars, struct AAF* aaf){
     else printf(",");
     for(int j = 0; j < aaf->number_of_arguments; j++){
       if(in_vars[j] == clause[i])
-        printf("%s", aaf->ids2arguments[j]);
+        printf("%s", taas__aaf_argument_name(aaf,j));
       else if(in_vars[j] == -clause[i])
-        printf("-%s", aaf->ids2arguments[j]);
+        printf("-%s", taas__aaf_argument_name(aaf,j));
     }
   }
   printf(">\n");
@@ -120,7 +177,7 @@ void printModel(IpasirSolver solver, int* in_vars, struct AAF* aaf){
     if(isFirst)
       isFirst = FALSE;
     else printf(",");
-    printf("%s", aaf->ids2arguments[i]);
+    printf("%s", taas__aaf_argument_name(aaf,i));
   }
   printf("}\n");
 }
@@ -39,23 +39,50 @@
 #include <glib.h>
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <random>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "util/bitset.c"
 #include "util/raset.c"
 #include "util/miscutil.c"
+#include "util/scheduler.c"
+#include "util/bignum.c"
 
 #include "taas/taas_aaf.c"
+#include "taas/taas_graph.c"
 #include "taas/taas_inout.c"
+#include "taas/taas_snapshot.c"
 #include "taas/taas_labeling.c"
+#include "taas/taas_reduct.c"
+#include "taas/taas_memo.c"
+#include "taas/taas_sidecar.c"
+#include "taas/taas_tractable.c"
+#include "taas/taas_tiny.c"
+#include "taas/taas_treedec.c"
+#include "taas/taas_ddnnf.c"
 #include "taas/taas_basics.c"
 
 #include "sat/ipasir_solver.cpp"
 
 #include "tasks/task_general.cpp"
+#include "tasks/task_scc.cpp"
 #include "tasks/task_se-pr.cpp"
 #include "tasks/task_ds-pr.cpp"
 #include "tasks/task_se-id.cpp"
@@ -69,15 +96,24 @@
 #include "tasks/task_dc-st.cpp"
 #include "tasks/task_ds-st.cpp"
 #include "tasks/task_ds-id.cpp"
+#include "tasks/task_ce-approx.cpp"
+#include "tasks/task_ce-cube.cpp"
 #include "tasks/task_ce-st.cpp"
 #include "tasks/task_ce-co.cpp"
 #include "tasks/task_ce-pr.cpp"
 #include "tasks/task_se-sst.cpp"
 #include "tasks/task_se-stg.cpp"
+#include "tasks/task_ddnnf.cpp"
 
 /* ============================================================================================================== */
 /* ============================================================================================================== */
 void solve_switch(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded) {
+  // (parts of) AAFs in tractable classes are solved without a SAT solver
+  if(taas__solve_tractable(task, aaf, grounded, TRUE))
+    return;
+  // tiny AAFs are solved exhaustively
+  if(tiny__solve(task, aaf))
+    return;
   // DS-PR
   if(strcmp(task->track,"DS-PR") == 0){
     solve_dspr(task, aaf, grounded);
@@ -114,7 +150,7 @@ void solve_switch(struct TaskSpecification *task, struct AAF* aaf, struct Labeli
       if(raset__contains(ideal,task->arg))
         printf("YES\n");
       else printf("NO\n");
-      raset__print_i23(ideal,aaf->ids2arguments);
+      raset__print_i23(ideal,aaf);
       raset__destroy(ideal);
     }else{
       solve_dsid(task, aaf, grounded);
@@ -166,7 +202,7 @@ int main(int argc, char *argv[]){
   // General solver information
 	struct SolverInformation *info = taas__solverinformation(
 			(char*) "taas-fudge v3.3.4 (2024-11-29)\nMatthias Thimm (matthias.thimm@fernuni-hagen.de), Federico Cerutti (federico.cerutti@unibs.it), Mauro Vallati (m.vallati@hud.ac.uk)",
-			(char*) "[i23]",
+			(char*) "[i23,tgf,bin]",
 			(char*) "[SE-GR,DC-GR,DS-GR,SE-CO,DC-CO,DS-CO,SE-PR,DC-PR,DS-PR,SE-ST,DC-ST,DS-ST,SE-ID,DC-ID,DS-ID,DC-SST,DS-SST,SE-SST,DC-STG,DS-STG,SE-STG]"
 		);
   return taas__solve(argc,argv,info,solve_switch);
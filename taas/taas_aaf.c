@@ -12,48 +12,445 @@
  */
 
 struct AAF{
-  /** Mapping internal argument identifiers (ints) to argument names **/
-  char** ids2arguments;
-  /** Mapping argument names to internal argument identifiers (ints)**/
+  /** Argument names: the name of argument i is names+names_idx[i]; if names
+      is NULL (e.g. for frameworks in ICCMA23 format) argument i is named i+1;
+      use taas__aaf_argument_name() for access **/
+  char* names;
+  size_t* names_idx;
+  /** Mapping argument names to internal argument identifiers (ints); may be
+      NULL, use taas__aaf_find_argument() for access **/
   GHashTable* arguments2ids;
   /** The number of arguments. */
   int number_of_arguments;
   /** The number of attacks. */
   int number_of_attacks;
-  /** Maps arguments to their children */
-  GSList** children;
-  /** Maps arguments to their parents */
-  GSList** parents;
-  /** Maps arguments to the number of their number of attackers
-     (after computing the grounded extension this equals the number
-      of attackers not already out in the grounded extension) */
+  /** Maps arguments to their children (compressed sparse row layout): the
+      children of argument i are children[children_idx[i]],...,
+      children[children_idx[i+1]-1], sorted and without duplicates */
+  int* children_idx;
+  int* children;
+  /** Maps arguments to their parents (same layout as children) */
+  int* parents_idx;
+  int* parents;
+  /** Maps arguments to the number of their attackers */
   int* number_of_attackers;
   /** The initial arguments (unattacked ones) */
   struct BitSet* initial;
   /** Self-attacking arguments */
   struct BitSet* loops;
+  /** If the AAF has been loaded from a snapshot, the memory mapping holding
+      the arrays above (NULL otherwise) */
+  void* mapping;
+  size_t mapping_size;
+  /** The hash of the AAF as read (0 until computed, cf. taas__aaf_hash()) */
+  uint64_t hash;
+  /** The strongly connected components (NULL until computed, cf.
+      taas__aaf_compute_sccs()): scc[i] is the component of argument i,
+      where components are numbered in topological order (if i attacks j
+      then scc[i] <= scc[j]); the arguments of component c are
+      scc_members[scc_idx[c]],...,scc_members[scc_idx[c+1]-1] */
+  int number_of_sccs;
+  int* scc;
+  int* scc_idx;
+  int* scc_members;
+  /** If the components have been loaded from a sidecar file, the memory
+      mapping holding them (NULL otherwise) */
+  void* sidecar;
+  size_t sidecar_size;
+  /** The optional adjacency bit-matrix (NULL unless built by
+      taas__aaf_build_matrix()): row i of matrix_parents (resp.
+      matrix_children) is the bitset of attackers (resp. attackees) of
+      argument i and consists of matrix_words words starting at
+      matrix_parents+i*matrix_words (rows are compatible with BitSet) */
+  bitset_word* matrix_parents;
+  bitset_word* matrix_children;
+  int matrix_words;
+  /** If the AAF is a sub-framework of another AAF, the original AAF, its
+      grounded labelling, and the original identifier origin_ids[i] of each
+      argument i (all NULL otherwise); the sub-framework is either the
+      undecided core of the original AAF (cf. taas__aaf_reduct()), or, if
+      origin_cone is TRUE, an unattacked part of it (cf. taas__aaf_cone()),
+      or its quotient (see origin_class below) */
+  struct AAF* origin;
+  struct Labeling* origin_grounded;
+  int* origin_ids;
+  char origin_cone;
+  /** If the AAF is a union of components of the original AAF that is solved
+      on its own, where its results are collected instead of printed (NULL
+      otherwise, cf. taas__solve_components()) */
+  struct ComponentResult* origin_result;
+  /** If the AAF is the quotient of the original AAF wrt. structural
+      equivalence, the argument of the AAF each original argument is merged
+      into (NULL otherwise, cf. taas__aaf_quotient()) */
+  int* origin_class;
+  /** The memo of results of components shared by the AAF and all its
+      sub-frameworks (NULL if there is none, cf. taas__aaf_scc_memo()) */
+  struct SccMemo* scc_memo;
 };
 
+/** Initialises an empty AAF */
+void taas__aaf_init(struct AAF* aaf){
+  aaf->names = NULL;
+  aaf->names_idx = NULL;
+  aaf->arguments2ids = NULL;
+  aaf->number_of_arguments = 0;
+  aaf->number_of_attacks = 0;
+  aaf->mapping = NULL;
+  aaf->mapping_size = 0;
+  aaf->hash = 0;
+  aaf->number_of_sccs = 0;
+  aaf->scc = NULL;
+  aaf->scc_idx = NULL;
+  aaf->scc_members = NULL;
+  aaf->sidecar = NULL;
+  aaf->sidecar_size = 0;
+  aaf->matrix_parents = NULL;
+  aaf->matrix_children = NULL;
+  aaf->matrix_words = 0;
+  aaf->origin = NULL;
+  aaf->origin_grounded = NULL;
+  aaf->origin_ids = NULL;
+  aaf->origin_cone = FALSE;
+  aaf->origin_result = NULL;
+  aaf->origin_class = NULL;
+  aaf->scc_memo = NULL;
+}
+
+/**
+ * Returns the name of the given argument. For unnamed arguments the name
+ * is written into a (thread-local) buffer which is overwritten by the
+ * next call. Arguments of a sub-framework are named as in the original AAF.
+ */
+const char* taas__aaf_argument_name(struct AAF* aaf, int arg){
+  if(aaf->origin != NULL)
+    return taas__aaf_argument_name(aaf->origin, aaf->origin_ids[arg]);
+  if(aaf->names != NULL)
+    return aaf->names + aaf->names_idx[arg];
+  static thread_local char name[12];
+  snprintf(name, sizeof(name), "%d", arg+1);
+  return name;
+}
+
+/**
+ * Returns the internal identifier of the argument with the given name,
+ * or -1 if there is no such argument.
+ */
+int taas__aaf_find_argument(struct AAF* aaf, char* name){
+  if(aaf->arguments2ids != NULL){
+    int* idx = (int*) g_hash_table_lookup(aaf->arguments2ids, name);
+    return idx == NULL ? -1 : *idx;
+  }
+  if(aaf->names == NULL){
+    char* end;
+    long arg = strtol(name, &end, 10);
+    if(end == name || *end != '\0' || arg < 1 || arg > aaf->number_of_arguments)
+      return -1;
+    return (int) arg - 1;
+  }
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    if(strcmp(aaf->names + aaf->names_idx[i], name) == 0)
+      return i;
+  return -1;
+}
+
+/**
+ * Builds the adjacency of the given AAF (children, parents, number_of_attackers,
+ * initial, loops) from the given attacks, where attacks[2k] attacks attacks[2k+1]
+ * for k=0,...,number_of_attacks-1. Duplicate attacks are removed and
+ * aaf->number_of_attacks is set to the number of distinct attacks.
+ */
+void taas__aaf_build_adjacency(struct AAF* aaf, int* attacks, int number_of_attacks){
+  int n = aaf->number_of_arguments;
+  // count the children of each argument and scatter the attacks
+  aaf->children_idx = (int*) calloc(n+1, sizeof(int));
+  for(int k = 0; k < number_of_attacks; k++)
+    aaf->children_idx[attacks[2*k]+1]++;
+  for(int i = 0; i < n; i++)
+    aaf->children_idx[i+1] += aaf->children_idx[i];
+  aaf->children = (int*) malloc((number_of_attacks+1) * sizeof(int));
+  int* pos = (int*) malloc((n+1) * sizeof(int));
+  memcpy(pos, aaf->children_idx, (n+1) * sizeof(int));
+  for(int k = 0; k < number_of_attacks; k++)
+    aaf->children[pos[attacks[2*k]]++] = attacks[2*k+1];
+  // sort each row and remove duplicates
+  int m = 0;
+  for(int i = 0; i < n; i++){
+    int start = aaf->children_idx[i];
+    int end = aaf->children_idx[i+1];
+    aaf->children_idx[i] = m;
+    std::sort(aaf->children + start, aaf->children + end);
+    for(int k = start; k < end; k++)
+      if(k == start || aaf->children[k] != aaf->children[k-1])
+        aaf->children[m++] = aaf->children[k];
+  }
+  aaf->children_idx[n] = m;
+  aaf->number_of_attacks = m;
+  // the parents are obtained by transposing; as the children are visited in
+  // ascending order of their parent, each row of parents is sorted as well
+  aaf->parents_idx = (int*) calloc(n+1, sizeof(int));
+  for(int k = 0; k < m; k++)
+    aaf->parents_idx[aaf->children[k]+1]++;
+  for(int i = 0; i < n; i++)
+    aaf->parents_idx[i+1] += aaf->parents_idx[i];
+  aaf->parents = (int*) malloc((m+1) * sizeof(int));
+  memcpy(pos, aaf->parents_idx, (n+1) * sizeof(int));
+  for(int i = 0; i < n; i++)
+    for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      aaf->parents[pos[aaf->children[k]]++] = i;
+  free(pos);
+  // number of attackers, initial (unattacked) and self-attacking arguments
+  aaf->number_of_attackers = (int*) malloc((n+1) * sizeof(int));
+  aaf->initial = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(aaf->initial, n);
+  bitset__unsetAll(aaf->initial);
+  aaf->loops = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(aaf->loops, n);
+  bitset__unsetAll(aaf->loops);
+  for(int i = 0; i < n; i++){
+    aaf->number_of_attackers[i] = aaf->parents_idx[i+1] - aaf->parents_idx[i];
+    if(aaf->number_of_attackers[i] == 0)
+      bitset__set(aaf->initial,i);
+    else if(std::binary_search(aaf->parents + aaf->parents_idx[i], aaf->parents + aaf->parents_idx[i+1], i))
+      bitset__set(aaf->loops,i);
+  }
+}
+
+/**
+ * Multi-threaded variant of taas__aaf_build_adjacency(): the attacks are
+ * given in several buffers (attacks[t] contains number_of_attacks[t] pairs)
+ * which are merged by parallel counting and scattering passes.
+ */
+void taas__aaf_build_adjacency_parallel(struct AAF* aaf, int** attacks, int* number_of_attacks, int number_of_buffers, int number_of_threads){
+  int n = aaf->number_of_arguments;
+  // count the children of each argument
+  aaf->children_idx = (int*) calloc(n+1, sizeof(int));
+  taas__parallel(number_of_buffers, [&](int t){
+    for(int k = 0; k < number_of_attacks[t]; k++)
+      __atomic_fetch_add(&aaf->children_idx[attacks[t][2*k]+1], 1, __ATOMIC_RELAXED);
+  });
+  for(int i = 0; i < n; i++)
+    aaf->children_idx[i+1] += aaf->children_idx[i];
+  // scatter the attacks
+  int* children = (int*) malloc((aaf->children_idx[n]+1) * sizeof(int));
+  int* pos = (int*) malloc((n+1) * sizeof(int));
+  memcpy(pos, aaf->children_idx, (n+1) * sizeof(int));
+  taas__parallel(number_of_buffers, [&](int t){
+    for(int k = 0; k < number_of_attacks[t]; k++)
+      children[__atomic_fetch_add(&pos[attacks[t][2*k]], 1, __ATOMIC_RELAXED)] = attacks[t][2*k+1];
+  });
+  // sort each row and remove duplicates (pos then holds the new row lengths)
+  taas__parallel_for(0, n, number_of_threads, [&](int lo, int hi){
+    for(int i = lo; i < hi; i++){
+      int* row = children + aaf->children_idx[i];
+      int len = aaf->children_idx[i+1] - aaf->children_idx[i];
+      std::sort(row, row + len);
+      pos[i] = std::unique(row, row + len) - row;
+    }
+  });
+  int* children_idx = (int*) malloc((n+1) * sizeof(int));
+  children_idx[0] = 0;
+  for(int i = 0; i < n; i++)
+    children_idx[i+1] = children_idx[i] + pos[i];
+  int m = children_idx[n];
+  aaf->children = (int*) malloc((m+1) * sizeof(int));
+  taas__parallel_for(0, n, number_of_threads, [&](int lo, int hi){
+    for(int i = lo; i < hi; i++)
+      memcpy(aaf->children + children_idx[i], children + aaf->children_idx[i], pos[i] * sizeof(int));
+  });
+  free(children);
+  free(aaf->children_idx);
+  aaf->children_idx = children_idx;
+  aaf->number_of_attacks = m;
+  // transpose for the parents
+  aaf->parents_idx = (int*) calloc(n+1, sizeof(int));
+  taas__parallel_for(0, n, number_of_threads, [&](int lo, int hi){
+    for(int k = aaf->children_idx[lo]; k < aaf->children_idx[hi]; k++)
+      __atomic_fetch_add(&aaf->parents_idx[aaf->children[k]+1], 1, __ATOMIC_RELAXED);
+  });
+  for(int i = 0; i < n; i++)
+    aaf->parents_idx[i+1] += aaf->parents_idx[i];
+  aaf->parents = (int*) malloc((m+1) * sizeof(int));
+  memcpy(pos, aaf->parents_idx, (n+1) * sizeof(int));
+  taas__parallel_for(0, n, number_of_threads, [&](int lo, int hi){
+    for(int i = lo; i < hi; i++)
+      for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+        aaf->parents[__atomic_fetch_add(&pos[aaf->children[k]], 1, __ATOMIC_RELAXED)] = i;
+  });
+  free(pos);
+  // number of attackers, initial (unattacked) and self-attacking arguments;
+  // arguments are processed in blocks of 1024 so that no two threads
+  // write to the same word of a bitset
+  aaf->number_of_attackers = (int*) malloc((n+1) * sizeof(int));
+  aaf->initial = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(aaf->initial, n);
+  bitset__unsetAll(aaf->initial);
+  aaf->loops = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(aaf->loops, n);
+  bitset__unsetAll(aaf->loops);
+  taas__parallel_for(0, (n+1023)/1024, number_of_threads, [&](int lo, int hi){
+    for(int i = lo*1024; i < hi*1024 && i < n; i++){
+      int* row = aaf->parents + aaf->parents_idx[i];
+      int len = aaf->parents_idx[i+1] - aaf->parents_idx[i];
+      std::sort(row, row + len);
+      aaf->number_of_attackers[i] = len;
+      if(len == 0)
+        bitset__set(aaf->initial,i);
+      else if(std::binary_search(row, row + len, i))
+        bitset__set(aaf->loops,i);
+    }
+  });
+}
+
+/**
+ * Returns the memo of results of components of the given AAF (or NULL),
+ * which is the one of the original AAF.
+ */
+struct SccMemo* taas__aaf_scc_memo(struct AAF* aaf){
+  while(aaf->origin != NULL)
+    aaf = aaf->origin;
+  return aaf->scc_memo;
+}
+
+/**
+ * Returns a 64-bit hash of the structure (arguments and attacks) of the
+ * given AAF; argument names are not taken into account. The hash is
+ * computed on the first call (or taken from the snapshot the AAF has been
+ * loaded from) and kept, so later calls take constant time and still
+ * return the hash of the AAF as read if it has been reduced to its kernel
+ * in the meantime (cf. taas__aaf_kernel()).
+ */
+uint64_t taas__aaf_hash(struct AAF* aaf){
+  if(aaf->hash != 0)
+    return aaf->hash;
+  uint64_t h = 0x9E3779B97F4A7C15ULL;
+  uint64_t values[2] = {(uint64_t) aaf->number_of_arguments, (uint64_t) aaf->number_of_attacks};
+  int* arrays[2] = {aaf->children_idx, aaf->children};
+  int lengths[2] = {aaf->number_of_arguments+1, aaf->number_of_attacks};
+  for(int i = 0; i < 2; i++){
+    h = (h ^ (values[i] * 0xFF51AFD7ED558CCDULL)) * 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 29;
+  }
+  for(int a = 0; a < 2; a++)
+    for(int k = 0; k < lengths[a]; k++){
+      h = (h ^ ((uint64_t)(uint32_t) arrays[a][k] * 0xFF51AFD7ED558CCDULL)) * 0xC4CEB9FE1A85EC53ULL;
+      h ^= h >> 29;
+    }
+  aaf->hash = h;
+  return h;
+}
+
 void taas__aaf_destroy(struct AAF* aaf){
-  for(int i = 0; i < aaf->number_of_arguments; i++){
-		free(aaf->ids2arguments[i]);
-    g_slist_free(aaf->children[i]);
-    g_slist_free(aaf->parents[i]);
-  }
-	free(aaf->ids2arguments);
-  free(aaf->children);
-  free(aaf->parents);
-	g_hash_table_destroy(aaf->arguments2ids);
+  if(aaf->mapping != NULL){
+    // all arrays live in the mapping
+    munmap(aaf->mapping, aaf->mapping_size);
+    free(aaf->initial);
+    free(aaf->loops);
+  }else{
+    free(aaf->names);
+    free(aaf->names_idx);
+    free(aaf->children_idx);
+    free(aaf->children);
+    free(aaf->parents_idx);
+    free(aaf->parents);
+    free(aaf->number_of_attackers);
+    bitset__destroy(aaf->initial);
+    bitset__destroy(aaf->loops);
+  }
+  if(aaf->sidecar != NULL)
+    munmap(aaf->sidecar, aaf->sidecar_size);
+  else{
+    free(aaf->scc);
+    free(aaf->scc_idx);
+    free(aaf->scc_members);
+  }
+  free(aaf->matrix_parents);
+  free(aaf->matrix_children);
+  free(aaf->origin_ids);
+  free(aaf->origin_class);
+  if(aaf->arguments2ids != NULL)
+	  g_hash_table_destroy(aaf->arguments2ids);
   free(aaf);
 }
 
+/**
+ * Builds the adjacency bit-matrix of the given AAF if it is not built yet
+ * and both directions together fit into budget bytes. Returns TRUE iff
+ * the matrix is available.
+ */
+int taas__aaf_build_matrix(struct AAF* aaf, size_t budget){
+  if(aaf->matrix_parents != NULL)
+    return TRUE;
+  int n = aaf->number_of_arguments;
+  size_t words = n/WORD_BITS+1;
+  if(2 * n * words * sizeof(bitset_word) > budget)
+    return FALSE;
+  aaf->matrix_words = words;
+  aaf->matrix_parents = (bitset_word*) calloc(n * words + 1, sizeof(bitset_word));
+  aaf->matrix_children = (bitset_word*) calloc(n * words + 1, sizeof(bitset_word));
+  for(int i = 0; i < n; i++)
+    for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++){
+      int j = aaf->children[k];
+      aaf->matrix_children[i * words + j / WORD_BITS] |= (bitset_word) 1 << (j % WORD_BITS);
+      aaf->matrix_parents[j * words + i / WORD_BITS] |= (bitset_word) 1 << (i % WORD_BITS);
+    }
+  return TRUE;
+}
+
 // Returns TRUE iff i attacks j
 int taas__aaf_isAttack(struct AAF* aaf, int i, int j){
-  for(GSList* node = aaf->children[i]; node != NULL; node = node->next)
-    if(*(int*)node->data == j)
+  if(aaf->matrix_children != NULL)
+    return (aaf->matrix_children[(size_t) i * aaf->matrix_words + j / WORD_BITS] >> (j % WORD_BITS)) & 1;
+  return std::binary_search(aaf->children + aaf->children_idx[i], aaf->children + aaf->children_idx[i+1], j);
+}
+
+/** Returns TRUE iff the given argument is attacked by some argument in set */
+int taas__aaf_is_attacked_by(struct AAF* aaf, int arg, struct RaSet* set){
+  if(aaf->matrix_parents != NULL){
+    bitset_word* row = aaf->matrix_parents + (size_t) arg * aaf->matrix_words;
+    for(int w = 0; w < aaf->matrix_words; w++)
+      if(row[w] & set->elements->data[w])
+        return TRUE;
+    return FALSE;
+  }
+  for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+    if(raset__contains(set, aaf->parents[k]))
       return TRUE;
   return FALSE;
 }
+
+/**
+ * If the bit-matrix is available, sets attacked (with matrix_words words)
+ * to the set of arguments attacked by some argument in set; to be used
+ * with taas__aaf_is_defended().
+ */
+void taas__aaf_attacked_by(struct AAF* aaf, struct RaSet* set, bitset_word* attacked){
+  memset(attacked, 0, aaf->matrix_words * sizeof(bitset_word));
+  for(int i = 0; i < set->number_of_elements; i++){
+    bitset_word* row = aaf->matrix_children + (size_t) set->elements_arr[i] * aaf->matrix_words;
+    for(int w = 0; w < aaf->matrix_words; w++)
+      attacked[w] |= row[w];
+  }
+}
+
+/**
+ * Returns TRUE iff every attacker of the given argument is attacked by some
+ * argument in set. If attacked is not NULL, it must contain the arguments
+ * attacked by set (cf. taas__aaf_attacked_by()) and the check is done
+ * word-parallel on the bit-matrix.
+ */
+int taas__aaf_is_defended(struct AAF* aaf, int arg, struct RaSet* set, bitset_word* attacked){
+  if(attacked != NULL){
+    bitset_word* row = aaf->matrix_parents + (size_t) arg * aaf->matrix_words;
+    for(int w = 0; w < aaf->matrix_words; w++)
+      if(row[w] & ~attacked[w])
+        return FALSE;
+    return TRUE;
+  }
+  for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+    if(!taas__aaf_is_attacked_by(aaf, aaf->parents[k], set))
+      return FALSE;
+  return TRUE;
+}
 /* ============================================================================================================== */
 /* == END FILE ================================================================================================== */
 /* ============================================================================================================== */
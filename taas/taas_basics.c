@@ -12,47 +12,105 @@
  */
 
 /**
- * Computes the grounded extension
+ * Computes the grounded extension in time O(n+m): arguments whose
+ * attackers are all out are added to a worklist, and each argument is
+ * processed at most once. The AAF is not modified.
  */
 void taas__compute_grounded(struct AAF* aaf, struct Labeling* grounded){
+	int n = aaf->number_of_arguments;
 	// all initial arguments are automatically in the grounded extension
   bitset__clone(aaf->initial, grounded->in);
 	// all arguments attacked by initial arguments are out
-	bitset__init(grounded->out, aaf->number_of_arguments);
+	bitset__init(grounded->out, n);
   bitset__unsetAll(grounded->out);
-	GSList* stack = (GSList*) malloc(sizeof(GSList*));
-	stack = NULL;
-	for(int a = bitset__next_set_bit(grounded->in,0); a != -1 ; a = bitset__next_set_bit(grounded->in, a+1)){
-		int* sidx = (int*) malloc(sizeof(int));
-		*sidx = a;
-		stack = g_slist_prepend(stack,sidx);
-	}
-	while(g_slist_length(stack)>0){
-		int* arg = (int*) stack->data;
-		stack = stack->next;
-		//printf("B: %s\n", aaf->ids2arguments[*arg]);
-		for(GSList* node = aaf->children[*arg]; node != NULL; node = node->next){
-			// if *(int*)node->data is already out, we can continue
-			if(bitset__get(grounded->out,*(int*)node->data))
+	// the number of attackers of each argument that are not (yet) out
+	int* attackers = (int*) malloc((n+1) * sizeof(int));
+	memcpy(attackers, aaf->number_of_attackers, n * sizeof(int));
+	// the in arguments whose children have not been processed yet
+	int* queue = (int*) malloc((n+1) * sizeof(int));
+	int head = 0, tail = 0;
+	for(int a = bitset__next_set_bit(grounded->in,0); a != -1 ; a = bitset__next_set_bit(grounded->in, a+1))
+		queue[tail++] = a;
+	while(head < tail){
+		int arg = queue[head++];
+		for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++){
+			int child = aaf->children[k];
+			// if child is already out, we can continue
+			if(bitset__get(grounded->out,child))
 				continue;
 			//argument is out
-			bitset__set(grounded->out,*(int*)node->data);
-			//decrease attack counter by one for each child of *(int*)node->data
-			for(GSList* node2 = aaf->children[*(int*)node->data]; node2 != NULL; node2 = node2->next){
-				if(aaf->number_of_attackers[*(int*)node2->data] > 0){
-					aaf->number_of_attackers[*(int*)node2->data]--;
-					if(aaf->number_of_attackers[*(int*)node2->data] == 0){
-						bitset__set(grounded->in,*(int*)node2->data);
-						int* sidx = (int*) malloc(sizeof(int));
-						*sidx = *(int*)node2->data;
-						//printf("C: %s\n", aaf->ids2arguments[*sidx]);
-						stack = g_slist_prepend(stack,sidx);
+			bitset__set(grounded->out,child);
+			//decrease attack counter by one for each child of child
+			for(int k2 = aaf->children_idx[child]; k2 < aaf->children_idx[child+1]; k2++){
+				int child2 = aaf->children[k2];
+				if(--attackers[child2] == 0){
+					bitset__set(grounded->in,child2);
+					queue[tail++] = child2;
+				}
+			}
+		}
+	}
+	free(attackers);
+	free(queue);
+}
+
+/** Frameworks with at least this many arguments are processed by several threads */
+#define TAAS_PARALLEL_GROUNDED_MIN_ARGUMENTS (1 << 22)
+
+/**
+ * Multi-threaded variant of taas__compute_grounded(): the fixpoint is
+ * computed in rounds, where each round processes the current frontier of
+ * in arguments in parallel (bits and attacker counters are updated
+ * atomically) and collects the next frontier. As the grounded extension
+ * is unique, the result is the same as for the sequential variant.
+ */
+void taas__compute_grounded_parallel(struct AAF* aaf, struct Labeling* grounded, int number_of_threads){
+	int n = aaf->number_of_arguments;
+  bitset__clone(aaf->initial, grounded->in);
+	bitset__init(grounded->out, n);
+  bitset__unsetAll(grounded->out);
+	int* attackers = (int*) malloc((n+1) * sizeof(int));
+	taas__parallel_for(0, n, number_of_threads, [&](int lo, int hi){
+		memcpy(attackers + lo, aaf->number_of_attackers + lo, (hi - lo) * sizeof(int));
+	});
+	// the current frontier and the parts of the next frontier collected by each thread
+	int* frontier = (int*) malloc((n+1) * sizeof(int));
+	std::vector<std::vector<int> > next(number_of_threads);
+	int frontier_size = 0;
+	for(int a = bitset__next_set_bit(grounded->in,0); a != -1 ; a = bitset__next_set_bit(grounded->in, a+1))
+		frontier[frontier_size++] = a;
+	while(frontier_size > 0){
+		// small frontiers are not worth spawning threads for
+		int threads = std::min(number_of_threads, 1 + frontier_size / 4096);
+		taas__parallel(threads, [&](int t){
+			next[t].clear();
+			for(int i = (long) frontier_size * t / threads; i < (long) frontier_size * (t+1) / threads; i++){
+				int arg = frontier[i];
+				for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++){
+					int child = aaf->children[k];
+					// only the thread that sets child out processes its children
+					if(!bitset__test_and_set_atomic(grounded->out,child))
+						continue;
+					for(int k2 = aaf->children_idx[child]; k2 < aaf->children_idx[child+1]; k2++){
+						int child2 = aaf->children[k2];
+						if(__atomic_sub_fetch(&attackers[child2], 1, __ATOMIC_RELAXED) == 0){
+							bitset__test_and_set_atomic(grounded->in,child2);
+							next[t].push_back(child2);
+						}
 					}
 				}
 			}
+		});
+		// concatenate the parts of the next frontier
+		frontier_size = 0;
+		for(int t = 0; t < threads; t++){
+			if(!next[t].empty())
+				memcpy(frontier + frontier_size, next[t].data(), next[t].size() * sizeof(int));
+			frontier_size += next[t].size();
 		}
-		free(arg);
 	}
+	free(attackers);
+	free(frontier);
 }
 
 /*bool fullcovered(struct Labeling* grounded, struct AAF* aaf){
@@ -72,6 +130,326 @@ char fullcovered(struct Labeling* grounded, struct AAF* aaf){
     return TRUE;
 }
 
+/** For SE problems, components with fewer arguments are solved together */
+#define TAAS_COMPONENT_MIN_ARGUMENTS 1024
+
+void taas__solve_components(struct TaskSpecification* task,
+				struct AAF* aaf,
+				struct Labeling* grounded,
+				void (*doSolve)(struct TaskSpecification*,struct AAF*, struct Labeling*));
+
+/**
+ * Solves the SE or CE problem of the task on the given parts of the AAF
+ * (cf. taas__aaf_split()), each of which is a union of weakly connected
+ * components, in parallel (largest first). The extensions of the AAF are
+ * exactly the unions of extensions of the parts, so witnesses are joined by
+ * union and counts are multiplied.
+ */
+void taas__solve_parts(struct TaskSpecification* task,
+				struct AAF* aaf,
+				struct Labeling* grounded,
+				void (*doSolve)(struct TaskSpecification*,struct AAF*, struct Labeling*),
+				int* part,
+				int number_of_parts){
+	struct AAF** parts = taas__aaf_split(aaf,part,number_of_parts);
+	struct BitSet* witness = (struct BitSet*) malloc(sizeof(struct BitSet));
+	bitset__init(witness, aaf->number_of_arguments);
+	bitset__unsetAll(witness);
+	struct ComponentResult* results = (struct ComponentResult*) calloc(number_of_parts+1, sizeof(struct ComponentResult));
+	int* order = (int*) malloc((number_of_parts+1) * sizeof(int));
+	for(int p = 0; p < number_of_parts; p++){
+		results[p].witness = witness;
+		parts[p]->origin_result = &results[p];
+		order[p] = p;
+	}
+	std::sort(order, order + number_of_parts, [&](int p1, int p2){
+		return parts[p1]->number_of_arguments > parts[p2]->number_of_arguments;
+	});
+	// the threads are shared by the workers, so that parts solved in
+	// parallel (e.g. by task_ce-cube.cpp) use at most the given threads
+	int number_of_workers = std::min(task->number_of_threads, number_of_parts);
+	struct TaskSpecification part_task = *task;
+	if(number_of_workers > 1)
+		part_task.number_of_threads = task->number_of_threads / number_of_workers;
+	std::atomic<int> next(0);
+	// set if a part has no extension, then so has the AAF
+	std::atomic<int> done(FALSE);
+	taas__parallel(number_of_workers, [&](int){
+		for(int i = next++; i < number_of_parts && !done.load(); i = next++){
+			int p = order[i];
+			struct Labeling* part_grounded = taas__lab_reduct(grounded,parts[p]);
+			// each part gets its own copy, as the track may be changed for
+			// the part (cf. taas__solve_tractable())
+			struct TaskSpecification local_task = part_task;
+			doSolve(&local_task,parts[p],part_grounded);
+			if(results[p].no_extension || (results[p].count != NULL && bignum__is_zero(results[p].count)))
+				done.store(TRUE);
+			taas__lab_destroy(part_grounded);
+			taas__aaf_destroy(parts[p]);
+			parts[p] = NULL;
+		}
+	});
+	if(strncmp(task->track,"CE",2) == 0){
+		// if done is set, some part has no extension
+		struct BigNum* count = (struct BigNum*) malloc(sizeof(struct BigNum));
+		bignum__init(count, done.load() ? 0 : 1);
+		for(int p = 0; p < number_of_parts && !done.load(); p++)
+			bignum__mul(count, results[p].count);
+		bignum__print(count);
+		printf("\n");
+		bignum__destroy(count);
+	}else{
+		int no_extension = FALSE;
+		for(int p = 0; p < number_of_parts; p++)
+			no_extension = no_extension || results[p].no_extension;
+		if(no_extension)
+			taas__print_no_extension(aaf);
+		else taas__print_witness(aaf,witness);
+	}
+	for(int p = 0; p < number_of_parts; p++){
+		if(parts[p] != NULL)
+			taas__aaf_destroy(parts[p]);
+		if(results[p].count != NULL)
+			bignum__destroy(results[p].count);
+	}
+	free(parts);
+	free(results);
+	free(order);
+	bitset__destroy(witness);
+}
+
+/**
+ * Decides the DC or DS problem of the task on the weakly connected
+ * component of the queried argument (given by part, cf.
+ * taas__aaf_compute_wccs()). The extensions of the AAF are the unions of
+ * extensions of its components, so the answer only depends on this
+ * component, except for stable semantics: if another component has no
+ * stable extension, neither has the AAF. Witnesses are completed by an
+ * extension of all other components.
+ */
+void taas__solve_query_component(struct TaskSpecification* task,
+				struct AAF* aaf,
+				struct Labeling* grounded,
+				void (*doSolve)(struct TaskSpecification*,struct AAF*, struct Labeling*),
+				int* part){
+	int c = part[task->arg];
+	// part 0 is the component of the query, part 1 consists of all others
+	for(int i = 0; i < aaf->number_of_arguments; i++)
+		part[i] = part[i] == c ? 0 : 1;
+	struct AAF** parts = taas__aaf_split(aaf,part,2);
+	struct ComponentResult result;
+	memset(&result, 0, sizeof(struct ComponentResult));
+	result.witness = (struct BitSet*) malloc(sizeof(struct BitSet));
+	bitset__init(result.witness, aaf->number_of_arguments);
+	bitset__unsetAll(result.witness);
+	parts[0]->origin_result = &result;
+	parts[1]->origin_result = &result;
+	struct Labeling* query_grounded = taas__lab_reduct(grounded,parts[0]);
+	struct Labeling* rest_grounded = taas__lab_reduct(grounded,parts[1]);
+	char* track = task->track;
+	char rest_track[8];
+	snprintf(rest_track, sizeof(rest_track), "SE-%s", track+3);
+	int stable = strcmp(track+3,"ST") == 0;
+	if(stable){
+		task->track = rest_track;
+		taas__solve_components(task,parts[1],rest_grounded,doSolve);
+		task->track = track;
+	}
+	if(stable && result.no_extension){
+		// the AAF has no stable extension
+		if(strncmp(track,"DC",2) == 0)
+			printf("NO\n");
+		else printf("YES\n");
+	}else{
+		int arg = task->arg;
+		result.has_witness = FALSE;
+		task->arg = taas__aaf_reduct_find(parts[0],arg);
+		doSolve(task,parts[0],query_grounded);
+		task->arg = arg;
+		if(result.has_witness){
+			if(!stable){
+				task->track = rest_track;
+				taas__solve_components(task,parts[1],rest_grounded,doSolve);
+				task->track = track;
+			}
+			taas__print_witness(aaf,result.witness);
+		}
+	}
+	taas__lab_destroy(query_grounded);
+	taas__lab_destroy(rest_grounded);
+	taas__aaf_destroy(parts[0]);
+	taas__aaf_destroy(parts[1]);
+	free(parts);
+	bitset__destroy(result.witness);
+}
+
+/**
+ * Calls doSolve on the weakly connected components of the given AAF: SE and
+ * CE problems are solved on all components in parallel (where small
+ * components are solved together for SE problems), and DC and DS problems
+ * only on the component of the queried argument. Complete and preferred
+ * queries are decided on the backward cone of the argument instead (cf.
+ * solve_cone()), which is part of its component; EA-PR prints in its own
+ * format.
+ */
+void taas__solve_components(struct TaskSpecification* task,
+				struct AAF* aaf,
+				struct Labeling* grounded,
+				void (*doSolve)(struct TaskSpecification*,struct AAF*, struct Labeling*)){
+	if(strcmp(task->track,"EA-PR") == 0 || strcmp(task->track,"DC-CO") == 0 ||
+			strcmp(task->track,"DC-PR") == 0 || strcmp(task->track,"DS-PR") == 0){
+		doSolve(task,aaf,grounded);
+		return;
+	}
+	int* part = (int*) malloc((aaf->number_of_arguments+1) * sizeof(int));
+	int number_of_parts = taas__aaf_compute_wccs(aaf,part);
+	if(number_of_parts > 1 && strncmp(task->track,"SE",2) == 0){
+		// merge consecutive small components
+		int* merged = (int*) malloc((number_of_parts+1) * sizeof(int));
+		int* sizes = (int*) calloc(number_of_parts+1, sizeof(int));
+		for(int i = 0; i < aaf->number_of_arguments; i++)
+			sizes[part[i]]++;
+		int number_of_merged = 0, size = TAAS_COMPONENT_MIN_ARGUMENTS;
+		for(int c = 0; c < number_of_parts; c++){
+			if(sizes[c] >= TAAS_COMPONENT_MIN_ARGUMENTS)
+				merged[c] = number_of_merged++;
+			else{
+				if(size >= TAAS_COMPONENT_MIN_ARGUMENTS){
+					number_of_merged++;
+					size = 0;
+				}
+				merged[c] = number_of_merged-1;
+				size += sizes[c];
+			}
+		}
+		for(int i = 0; i < aaf->number_of_arguments; i++)
+			part[i] = merged[part[i]];
+		number_of_parts = number_of_merged;
+		free(merged);
+		free(sizes);
+	}
+	if(number_of_parts <= 1)
+		doSolve(task,aaf,grounded);
+	else if(strncmp(task->track,"DC",2) == 0 || strncmp(task->track,"DS",2) == 0)
+		taas__solve_query_component(task,aaf,grounded,doSolve,part);
+	else taas__solve_parts(task,aaf,grounded,doSolve,part,number_of_parts);
+	free(part);
+}
+
+/**
+ * Calls doSolve (via taas__solve_components()) on the quotient of the given
+ * AAF wrt. structural equivalence (cf. taas__aaf_quotient()) if there are
+ * equivalent arguments, otherwise on the AAF itself. EA-PR prints in its
+ * own format.
+ */
+void taas__solve_quotient(struct TaskSpecification* task,
+				struct AAF* aaf,
+				struct Labeling* grounded,
+				void (*doSolve)(struct TaskSpecification*,struct AAF*, struct Labeling*)){
+	struct AAF* quotient = strcmp(task->track,"EA-PR") == 0 ? NULL : taas__aaf_quotient(aaf);
+	if(quotient == NULL){
+		taas__solve_components(task,aaf,grounded,doSolve);
+		return;
+	}
+	struct Labeling* quotient_grounded = taas__lab_reduct(grounded,quotient);
+	int arg = task->arg;
+	if(strncmp(task->track,"DC",2) == 0 || strncmp(task->track,"DS",2) == 0)
+		task->arg = quotient->origin_class[arg];
+	taas__solve_components(task,quotient,quotient_grounded,doSolve);
+	task->arg = arg;
+	taas__lab_destroy(quotient_grounded);
+	taas__aaf_destroy(quotient);
+}
+
+/**
+ * Returns the semantics (one of SEM_*) of the kernel that preserves what is
+ * needed for solving the task (cf. taas__aaf_kernel()), or 0 if there is
+ * none. DC-PR and DS-PR are solved via complete extensions (cf.
+ * solve_cone()), so they need the complete kernel.
+ */
+int taas__kernel_semantics(struct TaskSpecification* task){
+	const char* semantics = task->track+3;
+	if(strncmp(task->track,"EA",2) == 0)
+		return 0;
+	if(strcmp(semantics,"ST") == 0 || strcmp(semantics,"STG") == 0)
+		return SEM_ST;
+	if(strcmp(task->track,"SE-PR") == 0 || strcmp(task->track,"CE-PR") == 0 ||
+			strcmp(semantics,"SST") == 0 || strcmp(semantics,"ID") == 0)
+		return SEM_ADM;
+	if(strcmp(semantics,"CO") == 0 || strcmp(semantics,"PR") == 0)
+		return SEM_CO;
+	return 0;
+}
+
+/**
+ * Solves the task directly if the given AAF is in a tractable class (cf.
+ * taas__solve_tractable(), without the check for odd cycles, which needs
+ * the components of the whole AAF). Otherwise calls doSolve (via
+ * taas__solve_quotient()) on the kernel of the undecided core of the given
+ * AAF (cf. taas__aaf_reduct() and taas__aaf_kernel()) if this is sound for
+ * the task and actually removes arguments; the queried argument (if any)
+ * must be in the core. If not, doSolve is called on the AAF itself (on
+ * its kernel if nothing has been derived from it yet).
+ */
+void taas__solve_reduct(struct TaskSpecification* task,
+				struct AAF* aaf,
+				struct Labeling* grounded,
+				void (*doSolve)(struct TaskSpecification*,struct AAF*, struct Labeling*)){
+	if(taas__solve_tractable(task,aaf,grounded,FALSE))
+		return;
+	int n = aaf->number_of_arguments;
+	int undecided = n - bitset__count(grounded->in) - bitset__count(grounded->out);
+	int query = strncmp(task->track,"DC",2) == 0 || strncmp(task->track,"DS",2) == 0;
+	if(undecided == 0 || (query && (bitset__get(grounded->in,task->arg) || bitset__get(grounded->out,task->arg)))){
+		doSolve(task,aaf,grounded);
+		return;
+	}
+	int semantics = taas__kernel_semantics(task);
+	// stage semantics are not complete-based, and EA-PR prints in its own format
+	if(undecided == n || strstr(task->track,"STG") != NULL || strcmp(task->track,"EA-PR") == 0){
+		int removed = 0;
+		if(semantics != 0 && aaf->mapping == NULL && aaf->scc == NULL && aaf->matrix_parents == NULL)
+			removed = taas__aaf_kernel(aaf,semantics);
+		// the complete kernel only removes attacks among self-attacking
+		// arguments, so it has the same grounded labelling as the AAF
+		if(removed > 0 && semantics != SEM_CO){
+			// the kernel may have further unattacked arguments (which is
+			// sound, as the grounded extension of the kernel is contained in
+			// all its extensions wrt. the semantics the kernel is used for)
+			struct Labeling* kernel_grounded = (struct Labeling*) malloc(sizeof(struct Labeling));
+			taas__lab_init(kernel_grounded,FALSE);
+			taas__compute_grounded(aaf,kernel_grounded);
+			taas__solve_quotient(task,aaf,kernel_grounded,doSolve);
+			taas__lab_destroy(kernel_grounded);
+		}else taas__solve_quotient(task,aaf,grounded,doSolve);
+		return;
+	}
+	struct AAF* core = taas__aaf_reduct(aaf,grounded,undecided);
+	struct Labeling* core_grounded;
+	int removed = 0;
+	if(semantics != 0)
+		removed = taas__aaf_kernel(core,semantics);
+	if(removed > 0 && semantics != SEM_CO){
+		// as above
+		core_grounded = (struct Labeling*) malloc(sizeof(struct Labeling));
+		taas__lab_init(core_grounded,FALSE);
+		taas__compute_grounded(core,core_grounded);
+	}else{
+		// the grounded labelling of the core is empty
+		core_grounded = taas__lab_reduct(grounded,core);
+	}
+	int arg = task->arg;
+	if(query)
+		task->arg = taas__aaf_reduct_find(core,arg);
+	taas__solve_quotient(task,core,core_grounded,doSolve);
+	task->arg = arg;
+	taas__lab_destroy(core_grounded);
+	taas__aaf_destroy(core);
+}
+
+// defined in tasks/task_ddnnf.cpp
+int solve_ddnnf(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded, char* path);
+
 /**
  * The general solve method for taas solvers, handles easy cases
  * and does the input/output etc.
@@ -86,18 +464,50 @@ int taas__solve(int argc,
 		if(task != NULL){
 	    // read file
 	    struct AAF *aaf = (struct AAF*) malloc(sizeof(struct AAF));
+			taas__aaf_init(aaf);
 			// check formats
 			if(task->format != NULL && strcmp(task->format,"tgf") == 0)
 				taas__readFile_tgf(task->file,aaf);
+			else if(task->format != NULL && strcmp(task->format,"bin") == 0)
+				taas__readFile_bin(task->file,aaf);
 			else
-				taas__readFile_i23(task->file,aaf);
+				taas__readFile_i23(task->file,aaf,task->number_of_threads);
+			// write a snapshot of the AAF if asked for; if no problem is
+			// given, this is all there is to do
+			char* snapshot = taas__task_get_value(task,(char*)"-snapshot");
+			if(snapshot != NULL)
+				taas__writeFile_bin(snapshot,aaf);
+			if(task->track == NULL){
+				taas__aaf_destroy(aaf);
+				taas__solverinformation_destroy(info);
+				taas__cmd_destroy(task);
+				return 0;
+			}
 			// if DS or DC problem, parse argument under consideration
 			taas__update_arg_param(task,aaf);
 	    // this will hold the grounded extension
 	    struct Labeling* grounded;
 	    grounded = (struct Labeling*) malloc(sizeof(struct Labeling));
 	    taas__lab_init(grounded,FALSE);
-			taas__compute_grounded(aaf,grounded);
+			// results of components are memoised for this run (and, with a
+			// sidecar file, for later runs)
+			struct SccMemo memo;
+			aaf->scc_memo = &memo;
+			// the grounded extension is taken from the sidecar file (if given
+			// and up to date); otherwise it is computed and the sidecar written
+			char* sidecar = taas__task_get_value(task,(char*)"-cache");
+			if(sidecar == NULL || !taas__readFile_sidecar(sidecar,aaf,grounded)){
+				if(task->number_of_threads > 1 && aaf->number_of_arguments >= TAAS_PARALLEL_GROUNDED_MIN_ARGUMENTS)
+					taas__compute_grounded_parallel(aaf,grounded,task->number_of_threads);
+				else
+					taas__compute_grounded(aaf,grounded);
+				if(sidecar != NULL)
+					taas__writeFile_sidecar(sidecar,aaf,grounded);
+			}
+			// self-check (only if compiled without NDEBUG)
+			assert(taas__lab_check(aaf,grounded,SEM_CO));
+			// queries may be answered on a compiled encoding (if supported)
+			char* ddnnf = taas__task_get_value(task,(char*)"-ddnnf");
 			// check what queries we can already solve
 			if(strcmp(task->track,"SE-GR") == 0 || strcmp(task->track,"SE-CO") == 0){
 				printf("%s\n", taas__lab_print_i23(grounded,aaf));
@@ -127,7 +537,7 @@ int taas__solve(int argc,
 							task->track = (char*) "SE-SST";
 						else if(strcmp(task->track,"DC-ID") == 0)
 							task->track = (char*) "SE-ID";
-						doSolve(task,aaf,grounded);
+						taas__solve_reduct(task,aaf,grounded,doSolve);
 					}
 				}
 			}else if((strcmp(task->track,"DC-CO") == 0 ||
@@ -162,10 +572,12 @@ int taas__solve(int argc,
 							task->track = (char*) "SE-SST";
 						else if(strcmp(task->track,"DS-ID") == 0)
 							task->track = (char*) "SE-ID";
-						doSolve(task,aaf,grounded);
+						taas__solve_reduct(task,aaf,grounded,doSolve);
 				}
-			}else
-      	doSolve(task,aaf,grounded);
+			}else if(ddnnf == NULL || !solve_ddnnf(task,aaf,grounded,ddnnf))
+      	taas__solve_reduct(task,aaf,grounded,doSolve);
+			if(sidecar != NULL)
+				taas__writeFile_sidecar_memo(sidecar,aaf);
 	    taas__lab_destroy(grounded);
 	    taas__aaf_destroy(aaf);
 	  }
@@ -189,28 +601,28 @@ int taas__labeled_correctly(struct AAF* aaf, struct Labeling* lab, int arg){
 	int label = taas__lab_get_label(lab,arg);
 	if(label == LAB_IN){
 		// argument is "in"
-		for(GSList* node = aaf->children[arg]; node != NULL; node = node->next)
-			if(taas__lab_get_label(lab,*(int*)node->data) != LAB_OUT)
+		for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+			if(taas__lab_get_label(lab,aaf->children[k]) != LAB_OUT)
 				return FALSE;
-		for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next)
-			if(taas__lab_get_label(lab,*(int*)node->data) != LAB_OUT)
+		for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(taas__lab_get_label(lab,aaf->parents[k]) != LAB_OUT)
 				return FALSE;
 		return TRUE;
 	}
 	if(label == LAB_OUT){
 		// argument is "out"
-		for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next)
-			if(taas__lab_get_label(lab,*(int*)node->data) == LAB_IN)
+		for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(taas__lab_get_label(lab,aaf->parents[k]) == LAB_IN)
 				return TRUE;
 		return FALSE;
 	}
 	// argument is "undec"
-	for(GSList* node = aaf->children[arg]; node != NULL; node = node->next)
-		if(taas__lab_get_label(lab,*(int*)node->data) == LAB_IN)
+	for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+		if(taas__lab_get_label(lab,aaf->children[k]) == LAB_IN)
 			return FALSE;
 	int undec_attacker = FALSE;
-	for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next){
-		int attacker_label = taas__lab_get_label(lab,*(int*)node->data);
+	for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++){
+		int attacker_label = taas__lab_get_label(lab,aaf->parents[k]);
 		if(attacker_label == LAB_IN)
 			return FALSE;
 		if(attacker_label == LAB_UNDEC)
@@ -235,36 +647,36 @@ int taas__labeled_correctly_under_assumption(struct AAF* aaf, struct Labeling* l
 	int label = arg == arg_other ? lab_other : taas__lab_get_label(lab,arg);
 	if(label == LAB_IN){
 		// argument is "in"
-		for(GSList* node = aaf->children[arg]; node != NULL; node = node->next)
-			if(*(int*)node->data == arg_other && lab_other != LAB_OUT)
+		for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+			if(aaf->children[k] == arg_other && lab_other != LAB_OUT)
 				return FALSE;
-			else if(taas__lab_get_label(lab,*(int*)node->data) != LAB_OUT)
+			else if(taas__lab_get_label(lab,aaf->children[k]) != LAB_OUT)
 				return FALSE;
-		for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next)
-			if(*(int*)node->data == arg_other && lab_other != LAB_OUT)
+		for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(aaf->parents[k] == arg_other && lab_other != LAB_OUT)
 				return FALSE;
-			else if(taas__lab_get_label(lab,*(int*)node->data) != LAB_OUT)
+			else if(taas__lab_get_label(lab,aaf->parents[k]) != LAB_OUT)
 				return FALSE;
 		return TRUE;
 	}
 	if(label == LAB_OUT){
 		// argument is "out"
-		for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next)
-			if(*(int*)node->data == arg_other && lab_other == LAB_IN)
+		for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(aaf->parents[k] == arg_other && lab_other == LAB_IN)
 				return TRUE;
-			else if(taas__lab_get_label(lab,*(int*)node->data) == LAB_IN)
+			else if(taas__lab_get_label(lab,aaf->parents[k]) == LAB_IN)
 				return TRUE;
 		return FALSE;
 	}
 	// argument is "undec"
-	for(GSList* node = aaf->children[arg]; node != NULL; node = node->next)
-		if(*(int*)node->data == arg_other && lab_other != LAB_IN)
+	for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+		if(aaf->children[k] == arg_other && lab_other != LAB_IN)
 			return FALSE;
-		else if(taas__lab_get_label(lab,*(int*)node->data) == LAB_IN)
+		else if(taas__lab_get_label(lab,aaf->children[k]) == LAB_IN)
 			return FALSE;
 	int undec_attacker = FALSE;
-	for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next){
-		int attacker_label = *(int*)node->data == arg_other ? lab_other : taas__lab_get_label(lab,*(int*)node->data);
+	for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++){
+		int attacker_label = aaf->parents[k] == arg_other ? lab_other : taas__lab_get_label(lab,aaf->parents[k]);
 		if(attacker_label == LAB_IN)
 			return FALSE;
 		if(attacker_label == LAB_UNDEC)
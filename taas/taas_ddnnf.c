@@ -0,0 +1,701 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_ddnnf.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : A top-down compiler of CNFs to (smooth) decision-DNNF with
+               component caching, and linear-time passes over the compiled
+               circuits (satisfiability and models under assumptions, the
+               literals occurring in models, model counting), so that many
+               queries on the same encoding are answered without further
+               search. Circuits can be written to and mapped from files
+               (cf. tasks/task_ddnnf.cpp).
+ ============================================================================
+ */
+
+#define TAAS_DDNNF_MAGIC "TAASDNF"
+#define TAAS_DDNNF_VERSION 1
+
+/**
+ * Compilation is given up once the work done (cf. struct DDnnfCompiler)
+ * exceeds this, which bounds its time, or after this many nodes
+ */
+#define TAAS_DDNNF_MAX_WORK (1L << 25)
+#define TAAS_DDNNF_MAX_NODES (1 << 23)
+/** The maximal depth of nested decisions (compilation is recursive) */
+#define TAAS_DDNNF_MAX_DEPTH 10000
+/** The maximal number of integers in keys of the component cache */
+#define TAAS_DDNNF_MAX_CACHE (1L << 24)
+
+/**
+ * The types of nodes: a literal (value), a variable that may have either
+ * value (value), a conjunction of children over disjoint variables, and a
+ * decision on a variable (value) with two children over the same
+ * variables, the first one for the variable being true and the second one
+ * for it being false. All nodes below a node cover the same variables.
+ */
+#define DDNNF_FALSE 0
+#define DDNNF_TRUE 1
+#define DDNNF_LITERAL 2
+#define DDNNF_FREE 3
+#define DDNNF_AND 4
+#define DDNNF_DECISION 5
+
+/**
+ * A decision-DNNF over the variables 1,...,number_of_variables; the
+ * children of node i are children[children_idx[i]],...,
+ * children[children_idx[i+1]-1], which all are smaller than i.
+ */
+struct DDnnf{
+  int number_of_variables;
+  int number_of_nodes;
+  int root;
+  int* type;
+  int* value;
+  int* children_idx;
+  int* children;
+  /** If the arrays live in a mapped file, the mapping (cf. ddnnf__read()) */
+  char* mapping;
+  size_t mapping_size;
+};
+
+void ddnnf__destroy(struct DDnnf* d){
+  if(d->mapping != NULL)
+    munmap(d->mapping, d->mapping_size);
+  else{
+    free(d->type);
+    free(d->value);
+    free(d->children_idx);
+    free(d->children);
+  }
+  free(d);
+}
+
+/** The state of the compiler, with a CNF over the given variables */
+struct DDnnfCompiler{
+  int number_of_variables;
+  /** The literals of clause c are lits[clause_idx[c]],...,lits[clause_idx[c+1]-1] */
+  std::vector<int> clause_idx;
+  std::vector<int> lits;
+  /** The clauses containing literal l (cf. ddnnf__index()) */
+  std::vector<int> occurs_idx;
+  std::vector<int> occurs;
+  /** The values of variables (1 for true, -1 for false, 0 if unassigned) */
+  std::vector<signed char> value;
+  std::vector<int> trail;
+  /** The numbers of true and of unassigned literals of each clause */
+  std::vector<int> true_lits;
+  std::vector<int> open_lits;
+  /** The nodes compiled so far (in the layout of struct DDnnf) */
+  std::vector<int> type;
+  std::vector<int> node_value;
+  std::vector<int> children_idx;
+  std::vector<int> children;
+  /** The cache of compiled components, keyed by their variables and clauses */
+  std::unordered_multimap<uint64_t,int> cache;
+  std::vector<std::vector<int> > keys;
+  std::vector<int> key_nodes;
+  long cache_size;
+  /** Stamps of variables and clauses for finding components */
+  std::vector<int> var_stamp;
+  std::vector<int> clause_stamp;
+  int stamp;
+  std::vector<int> score;
+  /**
+   * The work done so far: the sizes of the components decided on (or
+   * found in the cache) and the occurrences of the variables assigned
+   */
+  long work;
+  int depth;
+  int failed;
+};
+
+/** Returns the index of the given literal in the occurrence lists */
+inline int ddnnf__index(int lit){
+  return lit > 0 ? 2*lit : -2*lit+1;
+}
+
+/** Adds a node to the circuit and returns its id */
+int ddnnf__node(struct DDnnfCompiler* c, int type, int value, int* children, int number_of_children){
+  c->type.push_back(type);
+  c->node_value.push_back(value);
+  c->children.insert(c->children.end(), children, children + number_of_children);
+  c->children_idx.push_back(c->children.size());
+  if((long) c->type.size() > TAAS_DDNNF_MAX_NODES)
+    c->failed = TRUE;
+  return c->type.size() - 1;
+}
+
+/** Sets the given literal to true */
+void ddnnf__assign(struct DDnnfCompiler* c, int lit){
+  c->value[abs(lit)] = lit > 0 ? 1 : -1;
+  c->trail.push_back(lit);
+  int l = ddnnf__index(lit);
+  for(int k = c->occurs_idx[l]; k < c->occurs_idx[l+1]; k++){
+    c->true_lits[c->occurs[k]]++;
+    c->open_lits[c->occurs[k]]--;
+  }
+  l = ddnnf__index(-lit);
+  for(int k = c->occurs_idx[l]; k < c->occurs_idx[l+1]; k++)
+    c->open_lits[c->occurs[k]]--;
+  c->work += c->occurs_idx[ddnnf__index(-abs(lit))+1] - c->occurs_idx[ddnnf__index(abs(lit))];
+}
+
+/** Takes back all assignments after the first mark ones */
+void ddnnf__undo(struct DDnnfCompiler* c, int mark){
+  while((int) c->trail.size() > mark){
+    int lit = c->trail.back();
+    c->trail.pop_back();
+    c->value[abs(lit)] = 0;
+    int l = ddnnf__index(lit);
+    for(int k = c->occurs_idx[l]; k < c->occurs_idx[l+1]; k++){
+      c->true_lits[c->occurs[k]]--;
+      c->open_lits[c->occurs[k]]++;
+    }
+    l = ddnnf__index(-lit);
+    for(int k = c->occurs_idx[l]; k < c->occurs_idx[l+1]; k++)
+      c->open_lits[c->occurs[k]]++;
+  }
+}
+
+/**
+ * Propagates the assignments on the trail from position qhead on by unit
+ * propagation; returns FALSE iff a clause is falsified.
+ */
+int ddnnf__propagate(struct DDnnfCompiler* c, int qhead){
+  while(qhead < (int) c->trail.size()){
+    int l = ddnnf__index(-c->trail[qhead++]);
+    for(int k = c->occurs_idx[l]; k < c->occurs_idx[l+1]; k++){
+      int cl = c->occurs[k];
+      if(c->true_lits[cl] > 0)
+        continue;
+      if(c->open_lits[cl] == 0)
+        return FALSE;
+      if(c->open_lits[cl] == 1)
+        for(int j = c->clause_idx[cl]; j < c->clause_idx[cl+1]; j++)
+          if(c->value[abs(c->lits[j])] == 0){
+            ddnnf__assign(c, c->lits[j]);
+            break;
+          }
+    }
+  }
+  return TRUE;
+}
+
+int ddnnf__compile_component(struct DDnnfCompiler* c, std::vector<int>& vars, std::vector<int>& clauses);
+
+/**
+ * Compiles the residual CNF over the given variables after the
+ * assignments on the trail from position from on (which must be
+ * propagated): the assigned literals, the unassigned variables in no
+ * unsatisfied clause, and the connected components of the remaining
+ * clauses are conjoined.
+ */
+int ddnnf__compile_residual(struct DDnnfCompiler* c, std::vector<int>& vars, int from){
+  std::vector<int> conjuncts;
+  for(int k = from; k < (int) c->trail.size(); k++)
+    conjuncts.push_back(ddnnf__node(c, DDNNF_LITERAL, c->trail[k], NULL, 0));
+  // all components are collected before any is compiled (which reuses the stamps)
+  std::vector<std::vector<int> > component_vars;
+  std::vector<std::vector<int> > component_clauses;
+  int stamp = ++c->stamp;
+  for(int v: vars){
+    if(c->value[v] != 0 || c->var_stamp[v] == stamp)
+      continue;
+    component_vars.emplace_back(1, v);
+    component_clauses.emplace_back();
+    std::vector<int>& cvars = component_vars.back();
+    std::vector<int>& cclauses = component_clauses.back();
+    c->var_stamp[v] = stamp;
+    for(size_t i = 0; i < cvars.size(); i++)
+      for(int l = ddnnf__index(cvars[i]); l <= ddnnf__index(-cvars[i]); l++)
+        for(int k = c->occurs_idx[l]; k < c->occurs_idx[l+1]; k++){
+          int cl = c->occurs[k];
+          if(c->true_lits[cl] > 0 || c->clause_stamp[cl] == stamp)
+            continue;
+          c->clause_stamp[cl] = stamp;
+          cclauses.push_back(cl);
+          for(int j = c->clause_idx[cl]; j < c->clause_idx[cl+1]; j++){
+            int w = abs(c->lits[j]);
+            if(c->value[w] == 0 && c->var_stamp[w] != stamp){
+              c->var_stamp[w] = stamp;
+              cvars.push_back(w);
+            }
+          }
+        }
+  }
+  for(size_t i = 0; i < component_vars.size(); i++){
+    int node;
+    if(component_clauses[i].empty())
+      node = ddnnf__node(c, DDNNF_FREE, component_vars[i][0], NULL, 0);
+    else node = ddnnf__compile_component(c, component_vars[i], component_clauses[i]);
+    if(node == DDNNF_FALSE)
+      return DDNNF_FALSE;
+    conjuncts.push_back(node);
+  }
+  if(conjuncts.empty())
+    return DDNNF_TRUE;
+  if(conjuncts.size() == 1)
+    return conjuncts[0];
+  return ddnnf__node(c, DDNNF_AND, 0, conjuncts.data(), conjuncts.size());
+}
+
+/**
+ * Compiles the connected component with the given (unassigned) variables
+ * and (unsatisfied) clauses by deciding on the variable occurring most
+ * often, unless the component is in the cache.
+ */
+int ddnnf__compile_component(struct DDnnfCompiler* c, std::vector<int>& vars, std::vector<int>& clauses){
+  if(c->failed)
+    return DDNNF_FALSE;
+  std::sort(vars.begin(), vars.end());
+  std::sort(clauses.begin(), clauses.end());
+  std::vector<int> key;
+  key.reserve(vars.size() + clauses.size() + 1);
+  key.push_back(vars.size());
+  key.insert(key.end(), vars.begin(), vars.end());
+  key.insert(key.end(), clauses.begin(), clauses.end());
+  uint64_t hash = memo__hash(key);
+  c->work += key.size();
+  auto range = c->cache.equal_range(hash);
+  for(auto it = range.first; it != range.second; ++it)
+    if(c->keys[it->second] == key)
+      return c->key_nodes[it->second];
+  if(c->work > TAAS_DDNNF_MAX_WORK || c->depth >= TAAS_DDNNF_MAX_DEPTH){
+    c->failed = TRUE;
+    return DDNNF_FALSE;
+  }
+  for(int cl: clauses)
+    for(int j = c->clause_idx[cl]; j < c->clause_idx[cl+1]; j++)
+      if(c->value[abs(c->lits[j])] == 0)
+        c->score[abs(c->lits[j])]++;
+  int var = vars[0];
+  for(int v: vars)
+    if(c->score[v] > c->score[var])
+      var = v;
+  for(int v: vars)
+    c->score[v] = 0;
+  int branch[2];
+  c->depth++;
+  for(int b = 0; b < 2; b++){
+    int mark = c->trail.size();
+    ddnnf__assign(c, b == 0 ? var : -var);
+    if(ddnnf__propagate(c, mark))
+      branch[b] = ddnnf__compile_residual(c, vars, mark+1);
+    else branch[b] = DDNNF_FALSE;
+    ddnnf__undo(c, mark);
+  }
+  c->depth--;
+  if(c->failed)
+    return DDNNF_FALSE;
+  int node = DDNNF_FALSE;
+  if(branch[0] != DDNNF_FALSE || branch[1] != DDNNF_FALSE)
+    node = ddnnf__node(c, DDNNF_DECISION, var, branch, 2);
+  if(c->cache_size + (long) key.size() <= TAAS_DDNNF_MAX_CACHE){
+    c->cache.insert(std::make_pair(hash, (int) c->keys.size()));
+    c->cache_size += key.size();
+    c->keys.push_back(key);
+    c->key_nodes.push_back(node);
+  }
+  return node;
+}
+
+/**
+ * Compiles the given CNF over the given number of variables (clauses are
+ * terminated by 0) to a decision-DNNF; returns NULL if compilation is
+ * given up (cf. TAAS_DDNNF_MAX_WORK).
+ */
+struct DDnnf* ddnnf__compile(int number_of_variables, std::vector<int>& cnf){
+  struct DDnnfCompiler* c = new DDnnfCompiler();
+  c->number_of_variables = number_of_variables;
+  // clauses are normalised: duplicate literals are removed and tautologies skipped
+  c->clause_idx.push_back(0);
+  int empty_clause = FALSE;
+  for(size_t start = 0, end = 0; start < cnf.size(); start = ++end){
+    while(cnf[end] != 0)
+      end++;
+    int* first = cnf.data() + start;
+    std::sort(first, cnf.data() + end);
+    int* last = std::unique(first, cnf.data() + end);
+    int tautology = FALSE;
+    for(int* lit = first; lit != last && *lit < 0; lit++)
+      tautology |= std::binary_search(first, last, -*lit);
+    if(tautology)
+      continue;
+    empty_clause |= first == last;
+    c->lits.insert(c->lits.end(), first, last);
+    c->clause_idx.push_back(c->lits.size());
+  }
+  int m = c->clause_idx.size() - 1;
+  int n = number_of_variables;
+  c->occurs_idx.assign(2*n+3, 0);
+  for(int lit: c->lits)
+    c->occurs_idx[ddnnf__index(lit)+1]++;
+  for(int l = 0; l < 2*n+2; l++)
+    c->occurs_idx[l+1] += c->occurs_idx[l];
+  c->occurs.resize(c->lits.size());
+  std::vector<int> pos(c->occurs_idx.begin(), c->occurs_idx.end() - 1);
+  for(int cl = 0; cl < m; cl++)
+    for(int j = c->clause_idx[cl]; j < c->clause_idx[cl+1]; j++)
+      c->occurs[pos[ddnnf__index(c->lits[j])]++] = cl;
+  c->value.assign(n+1, 0);
+  c->true_lits.assign(m, 0);
+  c->open_lits.resize(m);
+  for(int cl = 0; cl < m; cl++)
+    c->open_lits[cl] = c->clause_idx[cl+1] - c->clause_idx[cl];
+  c->var_stamp.assign(n+1, 0);
+  c->clause_stamp.assign(m, 0);
+  c->stamp = 0;
+  c->score.assign(n+1, 0);
+  c->cache_size = 0;
+  c->work = 0;
+  c->depth = 0;
+  c->failed = FALSE;
+  c->children_idx.push_back(0);
+  ddnnf__node(c, DDNNF_FALSE, 0, NULL, 0);
+  ddnnf__node(c, DDNNF_TRUE, 0, NULL, 0);
+  // unit clauses are propagated first
+  int consistent = !empty_clause;
+  for(int cl = 0; cl < m && consistent; cl++)
+    if(c->clause_idx[cl+1] - c->clause_idx[cl] == 1){
+      int lit = c->lits[c->clause_idx[cl]];
+      if(c->value[abs(lit)] == 0)
+        ddnnf__assign(c, lit);
+      else consistent = c->value[abs(lit)] == (lit > 0 ? 1 : -1);
+    }
+  std::vector<int> vars;
+  for(int v = 1; v <= n; v++)
+    vars.push_back(v);
+  int root = DDNNF_FALSE;
+  if(consistent && ddnnf__propagate(c, 0))
+    root = ddnnf__compile_residual(c, vars, 0);
+  struct DDnnf* d = NULL;
+  if(!c->failed){
+    d = (struct DDnnf*) malloc(sizeof(struct DDnnf));
+    d->number_of_variables = n;
+    d->number_of_nodes = c->type.size();
+    d->root = root;
+    d->type = (int*) malloc(c->type.size() * sizeof(int));
+    memcpy(d->type, c->type.data(), c->type.size() * sizeof(int));
+    d->value = (int*) malloc(c->node_value.size() * sizeof(int));
+    memcpy(d->value, c->node_value.data(), c->node_value.size() * sizeof(int));
+    d->children_idx = (int*) malloc(c->children_idx.size() * sizeof(int));
+    memcpy(d->children_idx, c->children_idx.data(), c->children_idx.size() * sizeof(int));
+    d->children = (int*) malloc((c->children.size()+1) * sizeof(int));
+    memcpy(d->children, c->children.data(), c->children.size() * sizeof(int));
+    d->mapping = NULL;
+    d->mapping_size = 0;
+  }
+  delete c;
+  return d;
+}
+
+/**
+ * Sets sat[i] to whether node i has a model agreeing with the given values
+ * of variables (1 for true, -1 for false, 0 for either).
+ */
+void ddnnf__satisfiable(struct DDnnf* d, signed char* fixed, char* sat){
+  for(int i = 0; i < d->number_of_nodes; i++){
+    int* child = d->children + d->children_idx[i];
+    int v = abs(d->value[i]);
+    switch(d->type[i]){
+      case DDNNF_FALSE:
+        sat[i] = FALSE;
+        break;
+      case DDNNF_LITERAL:
+        sat[i] = fixed[v] == 0 || (fixed[v] > 0) == (d->value[i] > 0);
+        break;
+      case DDNNF_AND:
+        sat[i] = TRUE;
+        for(int k = d->children_idx[i]; k < d->children_idx[i+1]; k++)
+          sat[i] = sat[i] && sat[d->children[k]];
+        break;
+      case DDNNF_DECISION:
+        sat[i] = (fixed[v] >= 0 && sat[child[0]]) || (fixed[v] <= 0 && sat[child[1]]);
+        break;
+      default:
+        sat[i] = TRUE;
+    }
+  }
+}
+
+/**
+ * Sets possible[ddnnf__index(l)] to whether the literal l is true in some
+ * model of the given d-DNNF agreeing with the given values (cf.
+ * ddnnf__satisfiable()), e.g. for every argument at once whether it is
+ * credulously resp. skeptically accepted.
+ */
+void ddnnf__literals(struct DDnnf* d, signed char* fixed, char* possible){
+  char* sat = (char*) malloc(d->number_of_nodes);
+  ddnnf__satisfiable(d, fixed, sat);
+  char* reached = (char*) calloc(d->number_of_nodes, 1);
+  memset(possible, 0, 2*d->number_of_variables+2);
+  reached[d->root] = sat[d->root];
+  // children have smaller ids than their parents
+  for(int i = d->root; i >= 0; i--){
+    if(!reached[i])
+      continue;
+    int* child = d->children + d->children_idx[i];
+    int v = abs(d->value[i]);
+    switch(d->type[i]){
+      case DDNNF_LITERAL:
+        possible[ddnnf__index(d->value[i])] = TRUE;
+        break;
+      case DDNNF_FREE:
+        possible[ddnnf__index(v)] |= fixed[v] >= 0;
+        possible[ddnnf__index(-v)] |= fixed[v] <= 0;
+        break;
+      case DDNNF_AND:
+        for(int k = d->children_idx[i]; k < d->children_idx[i+1]; k++)
+          reached[d->children[k]] = TRUE;
+        break;
+      case DDNNF_DECISION:
+        if(fixed[v] >= 0 && sat[child[0]]){
+          possible[ddnnf__index(v)] = TRUE;
+          reached[child[0]] = TRUE;
+        }
+        if(fixed[v] <= 0 && sat[child[1]]){
+          possible[ddnnf__index(-v)] = TRUE;
+          reached[child[1]] = TRUE;
+        }
+        break;
+    }
+  }
+  free(sat);
+  free(reached);
+}
+
+/**
+ * Sets model[v] (for v=1,...,number_of_variables) to the value of v in a
+ * model of the given d-DNNF agreeing with the given values (cf.
+ * ddnnf__satisfiable()) and returns TRUE; returns FALSE if there is none.
+ */
+int ddnnf__model(struct DDnnf* d, signed char* fixed, signed char* model){
+  char* sat = (char*) malloc(d->number_of_nodes);
+  ddnnf__satisfiable(d, fixed, sat);
+  int result = sat[d->root];
+  char* reached = (char*) calloc(d->number_of_nodes, 1);
+  memset(model, -1, d->number_of_variables+1);
+  reached[d->root] = result;
+  for(int i = d->root; i >= 0; i--){
+    if(!reached[i])
+      continue;
+    int* child = d->children + d->children_idx[i];
+    int v = abs(d->value[i]);
+    switch(d->type[i]){
+      case DDNNF_LITERAL:
+        model[v] = d->value[i] > 0 ? 1 : -1;
+        break;
+      case DDNNF_FREE:
+        model[v] = fixed[v] > 0 ? 1 : -1;
+        break;
+      case DDNNF_AND:
+        for(int k = d->children_idx[i]; k < d->children_idx[i+1]; k++)
+          reached[d->children[k]] = TRUE;
+        break;
+      case DDNNF_DECISION:
+        model[v] = fixed[v] >= 0 && sat[child[0]] ? 1 : -1;
+        reached[child[model[v] > 0 ? 0 : 1]] = TRUE;
+        break;
+    }
+  }
+  free(sat);
+  free(reached);
+  return result;
+}
+
+/**
+ * Sets count to the number of models of the given d-DNNF agreeing with
+ * the given values (cf. ddnnf__satisfiable()).
+ */
+void ddnnf__count(struct DDnnf* d, signed char* fixed, struct BigNum* count){
+  struct BigNum* counts = (struct BigNum*) malloc(d->number_of_nodes * sizeof(struct BigNum));
+  for(int i = 0; i < d->number_of_nodes; i++){
+    int* child = d->children + d->children_idx[i];
+    int v = abs(d->value[i]);
+    bignum__init(&counts[i], 0);
+    switch(d->type[i]){
+      case DDNNF_TRUE:
+        bignum__set_ulong(&counts[i], 1);
+        break;
+      case DDNNF_LITERAL:
+        bignum__set_ulong(&counts[i], fixed[v] == 0 || (fixed[v] > 0) == (d->value[i] > 0));
+        break;
+      case DDNNF_FREE:
+        bignum__set_ulong(&counts[i], fixed[v] == 0 ? 2 : 1);
+        break;
+      case DDNNF_AND:
+        bignum__set(&counts[i], &counts[child[0]]);
+        for(int k = d->children_idx[i]+1; k < d->children_idx[i+1]; k++)
+          bignum__mul(&counts[i], &counts[d->children[k]]);
+        break;
+      case DDNNF_DECISION:
+        if(fixed[v] >= 0)
+          bignum__add(&counts[i], &counts[child[0]]);
+        if(fixed[v] <= 0)
+          bignum__add(&counts[i], &counts[child[1]]);
+        break;
+    }
+  }
+  bignum__set(count, &counts[d->root]);
+  for(int i = 0; i < d->number_of_nodes; i++)
+    free(counts[i].digits);
+  free(counts);
+}
+
+/**
+ * The header of a file with a d-DNNF; sections are stored at the given
+ * offsets (as in snapshots, cf. taas_snapshot.c). A file without nodes
+ * records that compilation has been given up.
+ */
+struct DDnnfHeader{
+  char magic[8];
+  uint32_t version;
+  /** What has been compiled (cf. tasks/task_ddnnf.cpp) */
+  uint32_t kind;
+  uint64_t key;
+  int64_t number_of_variables;
+  int64_t number_of_nodes;
+  int64_t number_of_children;
+  int64_t root;
+  /** The size of the whole file */
+  int64_t size;
+  /** Section offsets */
+  int64_t type;
+  int64_t value;
+  int64_t children_idx;
+  int64_t children;
+};
+
+/**
+ * Writes the given d-DNNF (or, if it is NULL, the fact that compilation
+ * has been given up) for the given kind and key to the given path (under
+ * a temporary name first, as sidecar files).
+ */
+void ddnnf__write(char* path, struct DDnnf* d, uint32_t kind, uint64_t key){
+  char* tmp_path = (char*) malloc(strlen(path) + 32);
+  sprintf(tmp_path, "%s.%d.tmp", path, (int) getpid());
+  FILE* fp = fopen(tmp_path,"wb");
+  if(fp == NULL){
+    free(tmp_path);
+    return;
+  }
+  struct DDnnfHeader header;
+  memset(&header, 0, sizeof(struct DDnnfHeader));
+  memcpy(header.magic, TAAS_DDNNF_MAGIC, 8);
+  header.version = TAAS_DDNNF_VERSION;
+  header.kind = kind;
+  header.key = key;
+  fwrite(&header, 1, sizeof(struct DDnnfHeader), fp);
+  int64_t pos = sizeof(struct DDnnfHeader);
+  if(d != NULL){
+    int64_t nodes = d->number_of_nodes;
+    header.number_of_variables = d->number_of_variables;
+    header.number_of_nodes = nodes;
+    header.number_of_children = d->children_idx[nodes];
+    header.root = d->root;
+    header.type = taas__snapshot_write_section(fp, &pos, d->type, nodes * sizeof(int));
+    header.value = taas__snapshot_write_section(fp, &pos, d->value, nodes * sizeof(int));
+    header.children_idx = taas__snapshot_write_section(fp, &pos, d->children_idx, (nodes+1) * sizeof(int));
+    header.children = taas__snapshot_write_section(fp, &pos, d->children, header.number_of_children * sizeof(int));
+  }
+  header.size = pos;
+  fseek(fp, 0, SEEK_SET);
+  fwrite(&header, 1, sizeof(struct DDnnfHeader), fp);
+  if(fclose(fp) != 0 || rename(tmp_path, path) != 0)
+    unlink(tmp_path);
+  free(tmp_path);
+}
+
+/** Returns TRUE iff the arrays of the given d-DNNF form a valid circuit */
+int ddnnf__check(struct DDnnf* d){
+  int n = d->number_of_variables;
+  if(d->number_of_nodes < 2 || d->root < 0 || d->root >= d->number_of_nodes ||
+      d->type[DDNNF_FALSE] != DDNNF_FALSE || d->type[DDNNF_TRUE] != DDNNF_TRUE || d->children_idx[0] != 0)
+    return FALSE;
+  for(int i = 0; i < d->number_of_nodes; i++){
+    int number_of_children = d->children_idx[i+1] - d->children_idx[i];
+    int v = abs(d->value[i]);
+    if(number_of_children < 0 || d->type[i] < DDNNF_FALSE || d->type[i] > DDNNF_DECISION ||
+        ((d->type[i] == DDNNF_LITERAL || d->type[i] == DDNNF_FREE || d->type[i] == DDNNF_DECISION) && (v < 1 || v > n)) ||
+        (d->type[i] == DDNNF_AND && number_of_children < 1) ||
+        (d->type[i] == DDNNF_DECISION && number_of_children != 2) ||
+        (d->type[i] < DDNNF_AND && number_of_children != 0))
+      return FALSE;
+    for(int k = d->children_idx[i]; k < d->children_idx[i+1]; k++)
+      if(d->children[k] < 0 || d->children[k] >= i)
+        return FALSE;
+  }
+  return TRUE;
+}
+
+/**
+ * Reads the d-DNNF for the given kind and key from the given path (the
+ * arrays point into the mapped file). Returns 1 and sets d if the file
+ * holds a valid d-DNNF for them, 0 if it records that compilation has
+ * been given up for them, and -1 otherwise.
+ */
+int ddnnf__read(char* path, uint32_t kind, uint64_t key, struct DDnnf** d){
+  int fd = open(path, O_RDONLY);
+  if(fd < 0)
+    return -1;
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(struct DDnnfHeader)){
+    close(fd);
+    return -1;
+  }
+  char* data = (char*) mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED)
+    return -1;
+  struct DDnnfHeader* header = (struct DDnnfHeader*) data;
+  int64_t nodes = header->number_of_nodes;
+  if(memcmp(header->magic, TAAS_DDNNF_MAGIC, 8) != 0 ||
+      header->version != TAAS_DDNNF_VERSION ||
+      header->kind != kind ||
+      header->key != key ||
+      header->size != st.st_size){
+    munmap(data, st.st_size);
+    return -1;
+  }
+  if(nodes == 0){
+    munmap(data, st.st_size);
+    return 0;
+  }
+  struct DDnnfHeader h = *header;
+  int64_t sizes[4] = {nodes, nodes, nodes+1, h.number_of_children};
+  int64_t offsets[4] = {h.type, h.value, h.children_idx, h.children};
+  int valid = nodes > 0 && nodes < INT_MAX && h.number_of_variables > 0 && h.number_of_variables < INT_MAX &&
+    h.number_of_children >= 0 && h.number_of_children < INT_MAX && h.root >= 0 && h.root < nodes;
+  for(int s = 0; s < 4 && valid; s++)
+    valid = offsets[s] >= (int64_t) sizeof(struct DDnnfHeader) && offsets[s] % 8 == 0 &&
+      offsets[s] + sizes[s] * (int64_t) sizeof(int) <= h.size;
+  if(!valid){
+    munmap(data, st.st_size);
+    return -1;
+  }
+  *d = (struct DDnnf*) malloc(sizeof(struct DDnnf));
+  (*d)->number_of_variables = h.number_of_variables;
+  (*d)->number_of_nodes = nodes;
+  (*d)->root = h.root;
+  (*d)->type = (int*) (data + h.type);
+  (*d)->value = (int*) (data + h.value);
+  (*d)->children_idx = (int*) (data + h.children_idx);
+  (*d)->children = (int*) (data + h.children);
+  (*d)->mapping = data;
+  (*d)->mapping_size = st.st_size;
+  if((*d)->children_idx[nodes] != h.number_of_children || !ddnnf__check(*d)){
+    ddnnf__destroy(*d);
+    *d = NULL;
+    return -1;
+  }
+  return 1;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -0,0 +1,187 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_graph.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Graph-theoretic functions on AAFs for taas solvers.
+ ============================================================================
+ */
+
+/** Some structural features of an AAF */
+struct GraphStats{
+  int max_in_degree;
+  int max_out_degree;
+  int number_of_initial;
+  int number_of_loops;
+  int number_of_sccs;
+  int largest_scc;
+};
+
+/**
+ * Computes the strongly connected components of the given AAF (if not
+ * already computed) using an iterative version of Tarjan's algorithm.
+ */
+void taas__aaf_compute_sccs(struct AAF* aaf){
+  if(aaf->scc != NULL)
+    return;
+  int n = aaf->number_of_arguments;
+  aaf->scc = (int*) malloc((n+1) * sizeof(int));
+  int* index = (int*) malloc((n+1) * sizeof(int));
+  int* low = (int*) malloc((n+1) * sizeof(int));
+  // the position of the next child to be visited for each argument
+  int* next = (int*) malloc((n+1) * sizeof(int));
+  // the stack of Tarjan's algorithm and the call stack of the depth-first search
+  int* stack = (int*) malloc((n+1) * sizeof(int));
+  int* call = (int*) malloc((n+1) * sizeof(int));
+  for(int i = 0; i < n; i++){
+    index[i] = -1;
+    aaf->scc[i] = -1;
+  }
+  int counter = 0, stack_size = 0, number_of_sccs = 0;
+  for(int root = 0; root < n; root++){
+    if(index[root] != -1)
+      continue;
+    int call_size = 0;
+    call[call_size++] = root;
+    index[root] = low[root] = counter++;
+    next[root] = aaf->children_idx[root];
+    stack[stack_size++] = root;
+    while(call_size > 0){
+      int v = call[call_size-1];
+      if(next[v] < aaf->children_idx[v+1]){
+        int w = aaf->children[next[v]++];
+        if(index[w] == -1){
+          // descend
+          index[w] = low[w] = counter++;
+          next[w] = aaf->children_idx[w];
+          stack[stack_size++] = w;
+          call[call_size++] = w;
+        }else if(aaf->scc[w] == -1 && index[w] < low[v])
+          // w is still on the stack
+          low[v] = index[w];
+        continue;
+      }
+      // all children of v are visited
+      call_size--;
+      if(call_size > 0 && low[v] < low[call[call_size-1]])
+        low[call[call_size-1]] = low[v];
+      if(low[v] == index[v]){
+        int w;
+        do{
+          w = stack[--stack_size];
+          aaf->scc[w] = number_of_sccs;
+        }while(w != v);
+        number_of_sccs++;
+      }
+    }
+  }
+  // components are found in reverse topological order
+  for(int i = 0; i < n; i++)
+    aaf->scc[i] = number_of_sccs - 1 - aaf->scc[i];
+  aaf->number_of_sccs = number_of_sccs;
+  // group the arguments by component
+  aaf->scc_idx = (int*) calloc(number_of_sccs+1, sizeof(int));
+  for(int i = 0; i < n; i++)
+    aaf->scc_idx[aaf->scc[i]+1]++;
+  for(int c = 0; c < number_of_sccs; c++)
+    aaf->scc_idx[c+1] += aaf->scc_idx[c];
+  aaf->scc_members = (int*) malloc((n+1) * sizeof(int));
+  memcpy(next, aaf->scc_idx, (number_of_sccs+1) * sizeof(int));
+  for(int i = 0; i < n; i++)
+    aaf->scc_members[next[aaf->scc[i]]++] = i;
+  free(index);
+  free(low);
+  free(next);
+  free(stack);
+  free(call);
+}
+
+/**
+ * Sets cone (initialised with the number of arguments) to the arguments
+ * from which the given argument can be reached (including itself), i.e.
+ * the smallest unattacked set containing it. Returns the size of the cone.
+ */
+int taas__aaf_backward_cone(struct AAF* aaf, int arg, struct BitSet* cone){
+  bitset__unsetAll(cone);
+  int* stack = (int*) malloc((aaf->number_of_arguments+1) * sizeof(int));
+  int stack_size = 0, size = 1;
+  bitset__set(cone,arg);
+  stack[stack_size++] = arg;
+  while(stack_size > 0){
+    int v = stack[--stack_size];
+    for(int k = aaf->parents_idx[v]; k < aaf->parents_idx[v+1]; k++)
+      if(!bitset__get(cone,aaf->parents[k])){
+        bitset__set(cone,aaf->parents[k]);
+        stack[stack_size++] = aaf->parents[k];
+        size++;
+      }
+  }
+  free(stack);
+  return size;
+}
+
+/** Returns the root of the given argument in a union-find forest (with path halving) */
+int taas__uf_find(int* parent, int arg){
+  while(parent[arg] != arg){
+    parent[arg] = parent[parent[arg]];
+    arg = parent[arg];
+  }
+  return arg;
+}
+
+/**
+ * Computes the weakly connected components of the given AAF using a
+ * union-find forest: component[i] is the component of argument i, where
+ * components are numbered in the order of their smallest arguments.
+ * Returns the number of components.
+ */
+int taas__aaf_compute_wccs(struct AAF* aaf, int* component){
+  int n = aaf->number_of_arguments;
+  // the smaller root becomes the parent, so roots are the smallest arguments
+  int* parent = (int*) malloc((n+1) * sizeof(int));
+  for(int i = 0; i < n; i++)
+    parent[i] = i;
+  for(int i = 0; i < n; i++)
+    for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++){
+      int r1 = taas__uf_find(parent, i);
+      int r2 = taas__uf_find(parent, aaf->children[k]);
+      if(r1 < r2)
+        parent[r2] = r1;
+      else if(r2 < r1)
+        parent[r1] = r2;
+    }
+  int number_of_components = 0;
+  for(int i = 0; i < n; i++){
+    int root = taas__uf_find(parent, i);
+    component[i] = root == i ? number_of_components++ : component[root];
+  }
+  free(parent);
+  return number_of_components;
+}
+
+/**
+ * Computes the structural features of the given AAF (the components
+ * must have been computed already).
+ */
+void taas__aaf_compute_stats(struct AAF* aaf, struct GraphStats* stats){
+  memset(stats, 0, sizeof(struct GraphStats));
+  for(int i = 0; i < aaf->number_of_arguments; i++){
+    stats->max_in_degree = std::max(stats->max_in_degree, aaf->parents_idx[i+1] - aaf->parents_idx[i]);
+    stats->max_out_degree = std::max(stats->max_out_degree, aaf->children_idx[i+1] - aaf->children_idx[i]);
+    if(bitset__get(aaf->initial,i))
+      stats->number_of_initial++;
+    if(bitset__get(aaf->loops,i))
+      stats->number_of_loops++;
+  }
+  stats->number_of_sccs = aaf->number_of_sccs;
+  for(int c = 0; c < aaf->number_of_sccs; c++)
+    stats->largest_scc = std::max(stats->largest_scc, aaf->scc_idx[c+1] - aaf->scc_idx[c]);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -39,8 +39,16 @@ struct TaskSpecification{
   int number_of_additional_arguments;
   char** additional_keys;
   char** additional_values;
+  /** The number of threads to be used (additional argument "-threads") */
+  int number_of_threads;
+  /** The memory (in bytes) that may be used for the adjacency bit-matrix
+      (additional argument "-matrix_budget", given in MB) */
+  size_t matrix_budget;
 };
 
+/** The default memory budget (in MB) for the adjacency bit-matrix */
+#define TAAS_MATRIX_BUDGET_MB 64
+
 /**
  * initialises general solver information
  */
@@ -56,6 +64,8 @@ void taas__solverinformation_destroy(struct SolverInformation *info){
     free(info);
 }
 
+char* taas__task_get_value(struct TaskSpecification *task, char* key);
+
 /**
  * Handles the command. If basic solver information is asked for, NULL is returned;
  * otherwise the task specification is returned
@@ -69,16 +79,15 @@ struct TaskSpecification* taas__cmd_handle(int argc, char *argv[], struct Solver
   task->additional_keys = (char**) malloc(sizeof(char*));
   task->additional_values = (char**) malloc(sizeof(char*));
   task->format = NULL;
-  int param = 0;
+  task->track = NULL;
+  task->file = NULL;
   for(int i = 1; i < argc; i++){
     if(strcmp(argv[i],"-p") == 0){
       task->track = argv[++i];
-      param++;
       continue;
     }
     if(strcmp(argv[i],"-f") == 0){
       task->file = argv[++i];
-      param++;
       continue;
     }
     if(strcmp(argv[i],"-a") == 0){
@@ -87,7 +96,6 @@ struct TaskSpecification* taas__cmd_handle(int argc, char *argv[], struct Solver
     }
     if(strcmp(argv[i],"-fo") == 0){
       task->format = argv[++i];
-      param++;
       continue;
     }
     // for the parameter "--formats" print out the formats and exit
@@ -107,15 +115,26 @@ struct TaskSpecification* taas__cmd_handle(int argc, char *argv[], struct Solver
     task->additional_keys[task->number_of_additional_arguments-1] = argv[i];
     task->additional_values[task->number_of_additional_arguments-1] = argv[++i];
   }
-  //if no problem and file are given, just print out information
-  if(param < 2){
+  //if no file is given, or neither a problem nor a snapshot
+  //conversion (-snapshot) is asked for, just print out information
+  if(task->file == NULL || (task->track == NULL && taas__task_get_value(task,(char*)"-snapshot") == NULL)){
     printf("%s\n", info->description);
     return NULL;
   }
-  task->problem = (char*) malloc(3*sizeof(char));
-  memcpy(task->problem, task->track, 2);
-  task->problem[2] = '\0';
+  task->problem = NULL;
+  if(task->track != NULL){
+    task->problem = (char*) malloc(3*sizeof(char));
+    memcpy(task->problem, task->track, 2);
+    task->problem[2] = '\0';
+  }
   task->arg = -1;
+  // the number of threads defaults to the number of available cores
+  char* threads = taas__task_get_value(task,(char*)"-threads");
+  task->number_of_threads = threads != NULL ? atoi(threads) : (int) std::thread::hardware_concurrency();
+  if(task->number_of_threads < 1)
+    task->number_of_threads = 1;
+  char* matrix_budget = taas__task_get_value(task,(char*)"-matrix_budget");
+  task->matrix_budget = (size_t) (matrix_budget != NULL ? atol(matrix_budget) : TAAS_MATRIX_BUDGET_MB) << 20;
   return task;
 }
 
@@ -143,20 +162,26 @@ void taas__readFile_tgf(char* path, struct AAF* aaf){
   size_t len = 0;
   ssize_t read;
   int idx = 0;
+  size_t names_length = 0;
   while((read = getline(&row, &len, fp)) != -1) {
     if(strcmp(trimwhitespace(row),"") == 0)
       continue;
     if(strcmp(trimwhitespace(row),"#") == 0)
       break;
+    names_length += strlen(trimwhitespace(row)) + 1;
     idx++;
   }
   aaf->number_of_arguments = idx;
-  // now do the actual parsing
-  aaf->ids2arguments = (char**) malloc(aaf->number_of_arguments * sizeof(char*));
-	aaf->children = (GSList**) malloc(aaf->number_of_arguments * sizeof(GSList*));
-	aaf->parents = (GSList**) malloc(aaf->number_of_arguments * sizeof(GSList*));
+  fclose(fp);
+  // now do the actual parsing; all names are stored consecutively in aaf->names
+  aaf->names = (char*) malloc(names_length + 1);
+  aaf->names_idx = (size_t*) malloc((aaf->number_of_arguments + 1) * sizeof(size_t));
   aaf->arguments2ids = (GHashTable*) g_hash_table_new(g_str_hash, g_str_equal);
-  aaf->number_of_attackers = (int*) malloc(aaf->number_of_arguments * sizeof(int));
+  size_t names_pos = 0;
+  // attacks are collected as pairs (attacker,attacked)
+  int number_of_attacks = 0;
+  int attacks_capacity = 1024;
+  int* attacks = (int*) malloc(2 * attacks_capacity * sizeof(int));
 	fp = fopen(path,"r");
 	char* arg1;
 	int argumentSection = 1;
@@ -168,53 +193,210 @@ void taas__readFile_tgf(char* path, struct AAF* aaf){
       // switch section of file
 			argumentSection = 0;
 			aaf->number_of_arguments = idx;
-      aaf->number_of_attacks = 0;
-			aaf->initial = (struct BitSet*) malloc(sizeof(struct BitSet));
-			bitset__init(aaf->initial, aaf->number_of_arguments);
-      // all bits initially one
-      bitset__setAll(aaf->initial);
-      aaf->loops = (struct BitSet*) malloc(sizeof(struct BitSet));
-      bitset__init(aaf->loops, aaf->number_of_arguments);
-      // all bits initially zero
-      bitset__unsetAll(aaf->loops);
 			continue;
 		}
 		if(argumentSection != 0){
       // parse an argument
-      arg1 = (char*) malloc(sizeof(trimwhitespace(row))+1);
+      arg1 = aaf->names + names_pos;
       strcpy(arg1,trimwhitespace(row));
-			aaf->ids2arguments[idx] = arg1;
+      aaf->names_idx[idx] = names_pos;
+      names_pos += strlen(arg1) + 1;
       int* sidx = (int*) malloc(sizeof(int));
       *sidx = idx;
       g_hash_table_insert(aaf->arguments2ids,arg1,sidx);
-			aaf->children[idx] = NULL;
-			aaf->parents[idx] = NULL;
-      aaf->number_of_attackers[idx] = 0;
 			idx++;
 		}else{
       // parse an attack
-      aaf->number_of_attacks++;
 			idx = 0;
 			while(row[idx] != ' ')idx++;
 			row[idx] = 0;
       int* idx1 = (int*) g_hash_table_lookup(aaf->arguments2ids, row);
 			int* idx2 = (int*) g_hash_table_lookup(aaf->arguments2ids, &row[idx+1]);
-      aaf->children[*idx1] = g_slist_prepend(aaf->children[*idx1], idx2);
-      aaf->parents[*idx2] = g_slist_prepend(aaf->parents[*idx2], idx1);
-      aaf->number_of_attackers[*idx2]++;
-      // if an argument is attacked, it is not initial
-			bitset__unset(aaf->initial,*idx2);
-      // check for self-attacking arguments
-      if(*idx1 == *idx2){
-        bitset__set(aaf->loops,*idx1);
+      if(number_of_attacks == attacks_capacity){
+        attacks_capacity *= 2;
+        attacks = (int*) realloc(attacks, 2 * attacks_capacity * sizeof(int));
       }
+      attacks[2*number_of_attacks] = *idx1;
+      attacks[2*number_of_attacks+1] = *idx2;
+      number_of_attacks++;
 		}
 	}
   fclose(fp);
+  free(row);
+  taas__aaf_build_adjacency(aaf, attacks, number_of_attacks);
+  free(attacks);
+}
+
+/**
+ * Initialises the arguments "1",...,"n" of an AAF in ICCMA23 format; these
+ * names are not stored but derived from the identifiers on demand.
+ */
+void taas__init_arguments_i23(struct AAF* aaf){
+  aaf->names = NULL;
+  aaf->names_idx = NULL;
+  aaf->arguments2ids = NULL;
+}
+
+/**
+ * Returns the length of the run of decimal digits starting at p (not going
+ * beyond end); compares 16 bytes at once where SSE2 is available.
+ */
+inline size_t taas__scan_digits(const char* p, const char* end){
+  const char* start = p;
+#ifdef __SSE2__
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i nine = _mm_set1_epi8(9);
+  while(end - p >= 16){
+    __m128i v = _mm_sub_epi8(_mm_loadu_si128((const __m128i*) p), zero);
+    // a byte is a digit iff (byte-'0') <= 9 when compared unsigned
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, nine), v));
+    if(mask != 0xFFFF)
+      return (p - start) + __builtin_ctz(~mask);
+    p += 16;
+  }
+#endif
+  while(p < end && *p >= '0' && *p <= '9')
+    p++;
+  return p - start;
+}
+
+/** Parses the number given by the len digits starting at p */
+inline int taas__parse_digits(const char* p, size_t len){
+  int value = 0;
+  for(size_t i = 0; i < len; i++)
+    value = value * 10 + (p[i] - '0');
+  return value;
+}
+
+/**
+ * Tokenizes the attack lines in [p,end) of a file in ICCMA23 format and
+ * writes the attacks as pairs into the given buffer (which must have room
+ * for one attack per line); other lines (comments etc.) are skipped.
+ * Returns the number of attacks.
+ */
+int taas__tokenize_i23_attacks(const char* p, const char* end, int number_of_arguments, int* attacks){
+  int number_of_attacks = 0;
+  while(p < end){
+    // skip white space and empty lines
+    while(p < end && isspace(*p))
+      p++;
+    if(p == end)
+      break;
+    if(*p >= '0' && *p <= '9'){
+      // parse an attack
+      size_t len = taas__scan_digits(p, end);
+      int attacker = taas__parse_digits(p, len);
+      p += len;
+      while(p < end && (*p == ' ' || *p == '\t'))
+        p++;
+      len = taas__scan_digits(p, end);
+      int attacked = taas__parse_digits(p, len);
+      p += len;
+      if(len > 0 && attacker > 0 && attacked > 0 && attacker <= number_of_arguments && attacked <= number_of_arguments){
+        attacks[2*number_of_attacks] = attacker-1;
+        attacks[2*number_of_attacks+1] = attacked-1;
+        number_of_attacks++;
+      }
+    }
+    // skip the rest of the line (this also skips comments)
+    const char* eol = (const char*) memchr(p, '\n', end - p);
+    p = eol == NULL ? end : eol + 1;
+  }
+  return number_of_attacks;
+}
+
+/** Returns the number of lines in [p,end) (counting an unterminated last line) */
+size_t taas__count_lines(const char* p, const char* end){
+  size_t number_of_lines = 1;
+  for(const char* q = p; (q = (const char*) memchr(q, '\n', end - q)) != NULL; q++)
+    number_of_lines++;
+  return number_of_lines;
+}
+
+/** Files of at least this size are parsed by several threads */
+#define TAAS_PARALLEL_PARSING_MIN_BYTES (16 << 20)
+
+/**
+ * Reads a file in ICCMA23 format by memory-mapping it. Attack lines are
+ * tokenized in place and written into preallocated buffers, so there is
+ * no allocation per line. Large files are split at line boundaries into
+ * one chunk per thread, each of which is parsed into its own buffer.
+ * Returns FALSE (leaving aaf untouched) if the file cannot be mapped,
+ * e.g., if it is not a regular file.
+ */
+int taas__readFile_i23_mmap(char* path, struct AAF* aaf, int number_of_threads){
+  int fd = open(path, O_RDONLY);
+  if(fd < 0)
+    return FALSE;
+  struct stat st;
+  if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0){
+    close(fd);
+    return FALSE;
+  }
+  size_t size = st.st_size;
+  char* data = (char*) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED)
+    return FALSE;
+  madvise(data, size, MADV_SEQUENTIAL);
+  const char* end = data + size;
+  // find the header "p af <n>" (possibly preceded by comments)
+  int number_of_arguments = 0;
+  const char* p = data;
+  while(p < end){
+    while(p < end && isspace(*p))
+      p++;
+    if(p < end && *p == 'p'){
+      p++;
+      while(p < end && (isspace(*p) || *p == 'a' || *p == 'f'))
+        p++;
+      size_t len = taas__scan_digits(p, end);
+      number_of_arguments = taas__parse_digits(p, len);
+      p += len;
+      break;
+    }
+    const char* eol = (const char*) memchr(p, '\n', end - p);
+    p = eol == NULL ? end : eol + 1;
+  }
+  aaf->number_of_arguments = number_of_arguments;
+  if(size < TAAS_PARALLEL_PARSING_MIN_BYTES)
+    number_of_threads = 1;
+  // split the remaining file into chunks at line boundaries
+  const char** chunks = (const char**) malloc((number_of_threads+1) * sizeof(const char*));
+  chunks[0] = p;
+  for(int t = 1; t < number_of_threads; t++){
+    const char* q = p + (end - p) * t / number_of_threads;
+    if(q < chunks[t-1])
+      q = chunks[t-1];
+    const char* eol = (const char*) memchr(q, '\n', end - q);
+    chunks[t] = eol == NULL ? end : eol + 1;
+  }
+  chunks[number_of_threads] = end;
+  int** attacks = (int**) malloc(number_of_threads * sizeof(int*));
+  int* number_of_attacks = (int*) malloc(number_of_threads * sizeof(int));
+  taas__parallel(number_of_threads, [&](int t){
+    attacks[t] = (int*) malloc(2 * taas__count_lines(chunks[t], chunks[t+1]) * sizeof(int));
+    number_of_attacks[t] = taas__tokenize_i23_attacks(chunks[t], chunks[t+1], number_of_arguments, attacks[t]);
+  });
+  munmap(data, size);
+  taas__init_arguments_i23(aaf);
+  if(number_of_threads == 1)
+    taas__aaf_build_adjacency(aaf, attacks[0], number_of_attacks[0]);
+  else taas__aaf_build_adjacency_parallel(aaf, attacks, number_of_attacks, number_of_threads, number_of_threads);
+  for(int t = 0; t < number_of_threads; t++)
+    free(attacks[t]);
+  free(attacks);
+  free(number_of_attacks);
+  free(chunks);
+  return TRUE;
 }
 
 /** Read a file in ICCMA23 format into the data structures */
-void taas__readFile_i23(char* path, struct AAF* aaf){
+void taas__readFile_i23(char* path, struct AAF* aaf, int number_of_threads = 1){
+  // use the memory-mapped parser whenever possible; the line-based
+  // parser below is the fallback for inputs that cannot be mapped
+  if(taas__readFile_i23_mmap(path, aaf, number_of_threads))
+    return;
   // first get the number of arguments
   FILE* fp = fopen(path,"r");
   char* row = NULL;
@@ -229,62 +411,38 @@ void taas__readFile_i23(char* path, struct AAF* aaf){
     }
   }
   // now do the actual parsing
-  aaf->ids2arguments = (char**) malloc(aaf->number_of_arguments * sizeof(char*));
-  aaf->children = (GSList**) malloc(aaf->number_of_arguments * sizeof(GSList*));
-  aaf->parents = (GSList**) malloc(aaf->number_of_arguments * sizeof(GSList*));
-  aaf->arguments2ids = (GHashTable*) g_hash_table_new(g_str_hash, g_str_equal);
-  aaf->number_of_attackers = (int*) malloc(aaf->number_of_arguments * sizeof(int));
-  aaf->number_of_attacks = 0;
-  aaf->initial = (struct BitSet*) malloc(sizeof(struct BitSet));
-  bitset__init(aaf->initial, aaf->number_of_arguments);
-  // all bits initially one
-  bitset__setAll(aaf->initial);
-  aaf->loops = (struct BitSet*) malloc(sizeof(struct BitSet));
-  bitset__init(aaf->loops, aaf->number_of_arguments);
-  // all bits initially zero
-  bitset__unsetAll(aaf->loops);
-  // initialise arguments
-  for(int idx = 0; idx < aaf->number_of_arguments; idx++){
-    char *arg1 = (char*) malloc(sizeof(char)*(int)std::log10(idx+1)+2);
-    snprintf(arg1, (int)std::log10(idx+1)+2, "%d", idx+1);
-    aaf->ids2arguments[idx] = arg1;
-    int* sidx = (int*) malloc(sizeof(int));
-    *sidx = idx;
-    g_hash_table_insert(aaf->arguments2ids,arg1,sidx);
-    aaf->children[idx] = NULL;
-    aaf->parents[idx] = NULL;
-    aaf->number_of_attackers[idx] = 0;
-  }
+  taas__init_arguments_i23(aaf);
+  // attacks are collected as pairs (attacker,attacked)
+  int number_of_attacks = 0;
+  int attacks_capacity = 1024;
+  int* attacks = (int*) malloc(2 * attacks_capacity * sizeof(int));
 	while ((read = getline(&row, &len, fp)) != -1) {
     if(strcmp(trimwhitespace(row),"") == 0)
       continue;
 		if(strncmp(trimwhitespace(row),"#",1) == 0)
       continue;
     // parse an attack
-    aaf->number_of_attacks++;
 		int idx = 0;
 		while(row[idx] != ' ')idx++;
 		row[idx] = 0;
-    int* idx1 = (int*) malloc(sizeof(int));
-    int* idx2 = (int*) malloc(sizeof(int));
-    *idx1 = atoi(row)-1;
-		*idx2 = atoi(&row[idx+1])-1;
-    aaf->children[*idx1] = g_slist_prepend(aaf->children[*idx1], idx2);
-    aaf->parents[*idx2] = g_slist_prepend(aaf->parents[*idx2], idx1);
-    aaf->number_of_attackers[*idx2]++;
-    // if an argument is attacked, it is not initial
-		bitset__unset(aaf->initial,*idx2);
-    // check for self-attacking arguments
-    if(*idx1 == *idx2){
-      bitset__set(aaf->loops,*idx1);
+    if(number_of_attacks == attacks_capacity){
+      attacks_capacity *= 2;
+      attacks = (int*) realloc(attacks, 2 * attacks_capacity * sizeof(int));
     }
+    attacks[2*number_of_attacks] = atoi(row)-1;
+		attacks[2*number_of_attacks+1] = atoi(&row[idx+1])-1;
+    number_of_attacks++;
 	}
   fclose(fp);
+  free(row);
+  taas__aaf_build_adjacency(aaf, attacks, number_of_attacks);
+  free(attacks);
 }
+
 // if DS or DC problem, parse argument under consideration
 void taas__update_arg_param(struct TaskSpecification* task, struct AAF* aaf){
   if(strcmp(task->problem,"DS") == 0 || strcmp(task->problem,"DC") == 0)
-    task->arg = * (int*) g_hash_table_lookup(aaf->arguments2ids, trimwhitespace(task->argAsString));
+    task->arg = taas__aaf_find_argument(aaf, trimwhitespace(task->argAsString));
 }
 /* ============================================================================================================== */
 /* == END FILE ================================================================================================== */
@@ -48,8 +48,7 @@ void taas__lab_randomize(struct Labeling* lab){
   bitset__randomize(lab->in);
   if(!lab->twoValued){
     bitset__randomize(lab->out);
-    for(int i = 0; i < lab->in->num_elements; i++)
-      lab->out->data[i] = lab->out->data[i] & ~lab->in->data[i];
+    bitset__andnot(lab->out,lab->in);
   }
 }
 
@@ -57,18 +56,11 @@ void taas__lab_randomize(struct Labeling* lab){
  * Returns the label of the given argument.
  */
 int taas__lab_get_label(struct Labeling* lab, int arg){
-  if(lab->twoValued){
-    if(bitset__get(lab->in,arg))
-      return LAB_IN;
-    else return LAB_OUT;
-  }
-  if(bitset__get(lab->in,arg) && !bitset__get(lab->out,arg))
-    return LAB_IN;
-  if(!bitset__get(lab->in,arg) && bitset__get(lab->out,arg))
-    return LAB_OUT;
-  if(!bitset__get(lab->in,arg) && !bitset__get(lab->out,arg))
-    return LAB_UNDEC;
-  return LAB_UNLABELED;
+  static const int labels[4] = {LAB_UNDEC, LAB_IN, LAB_OUT, LAB_UNLABELED};
+  int in = bitset__get(lab->in,arg);
+  if(lab->twoValued)
+    return in ? LAB_IN : LAB_OUT;
+  return labels[in | (bitset__get(lab->out,arg) << 1)];
 }
 
 /**
@@ -109,18 +101,19 @@ char* taas__lab_print(struct Labeling* lab, struct AAF* aaf){
     // if there is also a bit set in lab->out it means the argument is unlabeled, so skip it
     if(!lab->twoValued && bitset__get(lab->out,idx))
       continue;
-    if(sidx + strlen(aaf->ids2arguments[idx]) + 4 > len){
+    const char* name = taas__aaf_argument_name(aaf,idx);
+    if(sidx + strlen(name) + 4 > len){
       len += 100;
       str = (char*) realloc(str, len);
     }
     if(isFirst != 0){
-      strcpy(&str[sidx],aaf->ids2arguments[idx]);
-      sidx += strlen(aaf->ids2arguments[idx]);
+      strcpy(&str[sidx],name);
+      sidx += strlen(name);
       isFirst = 0;
     } else{
       str[sidx++] = ',';
-      strcpy(&str[sidx],aaf->ids2arguments[idx]);
-      sidx += strlen(aaf->ids2arguments[idx]);
+      strcpy(&str[sidx],name);
+      sidx += strlen(name);
     }
   }
   str[sidx++] = ']';
@@ -143,18 +136,19 @@ char* taas__lab_print_i23(struct Labeling* lab, struct AAF* aaf){
     // if there is also a bit set in lab->out it means the argument is unlabeled, so skip it
     if(!lab->twoValued && bitset__get(lab->out,idx))
       continue;
-    if(sidx + strlen(aaf->ids2arguments[idx]) + 4 > len){
+    const char* name = taas__aaf_argument_name(aaf,idx);
+    if(sidx + strlen(name) + 4 > len){
       len += 100;
       str = (char*) realloc(str, len);
     }
     if(isFirst != 0){
-      strcpy(&str[sidx],aaf->ids2arguments[idx]);
-      sidx += strlen(aaf->ids2arguments[idx]);
+      strcpy(&str[sidx],name);
+      sidx += strlen(name);
       isFirst = 0;
     } else{
       str[sidx++] = ' ';
-      strcpy(&str[sidx],aaf->ids2arguments[idx]);
-      sidx += strlen(aaf->ids2arguments[idx]);
+      strcpy(&str[sidx],name);
+      sidx += strlen(name);
     }
   }
   str[sidx] = '\0';
@@ -172,13 +166,14 @@ char* taas__lab_print_as_labeling(struct Labeling* lab, struct AAF* aaf){
   str[sidx++] = '[';
   int isFirst = 1;
   for(int idx = 0; idx < aaf->number_of_arguments; idx++){
-    if(sidx + strlen(aaf->ids2arguments[idx]) + 6 > len){
+    const char* name = taas__aaf_argument_name(aaf,idx);
+    if(sidx + strlen(name) + 6 > len){
       len += 100;
       str = (char*) realloc(str, len);
     }
     if(isFirst != 0){
-      strcpy(&str[sidx],aaf->ids2arguments[idx]);
-      sidx += strlen(aaf->ids2arguments[idx]);
+      strcpy(&str[sidx],name);
+      sidx += strlen(name);
       str[sidx++] = '=';
       if(taas__lab_get_label(lab,idx) == LAB_IN)
         str[sidx++] = 'I';
@@ -191,8 +186,8 @@ char* taas__lab_print_as_labeling(struct Labeling* lab, struct AAF* aaf){
       isFirst = 0;
     } else{
       str[sidx++] = ',';
-      strcpy(&str[sidx],aaf->ids2arguments[idx]);
-      sidx += strlen(aaf->ids2arguments[idx]);
+      strcpy(&str[sidx],name);
+      sidx += strlen(name);
       str[sidx++] = '=';
       if(taas__lab_get_label(lab,idx) == LAB_IN)
         str[sidx++] = 'I';
@@ -221,5 +216,173 @@ void taas__lab_destroy(struct Labeling* lab){
 }
 
  /* ============================================================================================================== */
+/* ============================================================================================================== */
+/* Packed labelings                                                                                               */
+/* ============================================================================================================== */
+
+/* 2-bit codes of labels in packed labelings */
+#define PLAB_UNDEC 0
+#define PLAB_IN 1
+#define PLAB_OUT 2
+#define PLAB_UNLABELED 3
+
+/* semantics that can be checked by taas__plab_check() (ordered by strength) */
+#define SEM_CF 1
+#define SEM_ADM 2
+#define SEM_CO 3
+#define SEM_ST 4
+
+/**
+ * Struct for labelings with two bits per argument (cf. the PLAB_* codes),
+ * where the labels of 32 arguments are packed into one word; this allows
+ * reading a label with one lookup.
+ */
+struct PackedLabeling{
+  uint64_t* data;
+  // number of arguments
+  int length;
+  // number of words
+  int num_elements;
+};
+
+/** Initialises a packed labeling where all arguments are undecided */
+void taas__plab_init(struct PackedLabeling* plab, int length){
+  plab->length = length;
+  plab->num_elements = length/32+1;
+  plab->data = (uint64_t*) calloc(plab->num_elements, sizeof(uint64_t));
+}
+
+/** Frees the memory of a packed labeling */
+void taas__plab_destroy(struct PackedLabeling* plab){
+  free(plab->data);
+}
+
+/** Returns the 2-bit code (PLAB_*) of the label of the given argument */
+inline int taas__plab_get_code(struct PackedLabeling* plab, int arg){
+  return (plab->data[arg / 32] >> (2 * (arg % 32))) & 3;
+}
+
+/** Returns the label (LAB_*) of the given argument */
+int taas__plab_get_label(struct PackedLabeling* plab, int arg){
+  static const int labels[4] = {LAB_UNDEC, LAB_IN, LAB_OUT, LAB_UNLABELED};
+  return labels[taas__plab_get_code(plab,arg)];
+}
+
+/** Sets the label (LAB_*) of the given argument */
+void taas__plab_set_label(struct PackedLabeling* plab, int arg, int label){
+  uint64_t code = label == LAB_IN ? PLAB_IN : label == LAB_OUT ? PLAB_OUT : label == LAB_UNDEC ? PLAB_UNDEC : PLAB_UNLABELED;
+  int shift = 2 * (arg % 32);
+  plab->data[arg / 32] = (plab->data[arg / 32] & ~((uint64_t) 3 << shift)) | (code << shift);
+}
+
+/** Spreads the 32 bits of x to the even bit positions of the result */
+inline uint64_t taas__plab_spread(uint64_t x){
+  x &= 0xFFFFFFFFULL;
+  x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+  x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+  x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  x = (x | (x << 2)) & 0x3333333333333333ULL;
+  x = (x | (x << 1)) & 0x5555555555555555ULL;
+  return x;
+}
+
+/**
+ * Sets the packed labeling to the given labeling; the bits of in and out
+ * are interleaved a word at a time.
+ */
+void taas__plab_from_labeling(struct PackedLabeling* plab, struct Labeling* lab){
+  for(int w = 0; w < plab->num_elements; w++){
+    // word w of plab covers the arguments 32w,...,32w+31
+    bitset_word in = lab->in->data[w / 2] >> (32 * (w % 2));
+    bitset_word out = lab->twoValued ? ~in : lab->out->data[w / 2] >> (32 * (w % 2));
+    plab->data[w] = taas__plab_spread(in) | (taas__plab_spread(out) << 1);
+  }
+}
+
+/**
+ * Sets the packed labeling to the labeling induced by the given set of
+ * arguments: arguments in the set are in, arguments attacked by the set
+ * are out, and all other arguments are undecided.
+ */
+void taas__plab_from_set(struct PackedLabeling* plab, struct AAF* aaf, struct BitSet* set){
+  struct BitSet* attacked = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(attacked, aaf->number_of_arguments);
+  bitset__unsetAll(attacked);
+  for(int a = bitset__next_set_bit(set,0); a != -1 ; a = bitset__next_set_bit(set, a+1))
+    for(int k = aaf->children_idx[a]; k < aaf->children_idx[a+1]; k++)
+      bitset__set(attacked, aaf->children[k]);
+  bitset__andnot(attacked, set);
+  for(int w = 0; w < plab->num_elements; w++)
+    plab->data[w] = taas__plab_spread(set->data[w / 2] >> (32 * (w % 2))) |
+                    (taas__plab_spread(attacked->data[w / 2] >> (32 * (w % 2))) << 1);
+  bitset__destroy(attacked);
+}
+
+/**
+ * Checks in a single pass over the attackers of all arguments whether the
+ * given (complete) packed labeling is a conflict-free, admissible, complete,
+ * or stable labeling (semantics is one of SEM_*), i.e. whether
+ * - (SEM_CF) no argument labeled "in" has an attacker labeled "in"
+ * - (SEM_ADM) all attackers of arguments labeled "in" are labeled "out" and
+ *   all arguments labeled "out" have an attacker labeled "in"
+ * - (SEM_CO) additionally, all arguments labeled "undec" have no attacker
+ *   labeled "in" and not all attackers labeled "out"
+ * - (SEM_ST) additionally, no argument is labeled "undec".
+ */
+int taas__plab_check(struct AAF* aaf, struct PackedLabeling* plab, int semantics){
+  for(int arg = 0; arg < aaf->number_of_arguments; arg++){
+    int code = taas__plab_get_code(plab,arg);
+    if(code == PLAB_UNLABELED)
+      return FALSE;
+    if(code == PLAB_UNDEC && semantics == SEM_ST)
+      return FALSE;
+    if((code == PLAB_OUT && semantics == SEM_CF) || (code == PLAB_UNDEC && semantics < SEM_CO))
+      continue;
+    int in_attacker = FALSE, other_attacker = FALSE;
+    for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++){
+      int attacker_code = taas__plab_get_code(plab,aaf->parents[k]);
+      if(attacker_code == PLAB_IN){
+        in_attacker = TRUE;
+        break;
+      }
+      if(attacker_code != PLAB_OUT)
+        other_attacker = TRUE;
+    }
+    if(code == PLAB_IN && (in_attacker || (semantics >= SEM_ADM && other_attacker)))
+      return FALSE;
+    if(code == PLAB_OUT && !in_attacker)
+      return FALSE;
+    if(code == PLAB_UNDEC && (in_attacker || !other_attacker))
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/**
+ * Returns TRUE iff the given labeling is a labeling wrt. the given
+ * semantics (one of SEM_*); used for self-checking.
+ */
+int taas__lab_check(struct AAF* aaf, struct Labeling* lab, int semantics){
+  struct PackedLabeling plab;
+  taas__plab_init(&plab, aaf->number_of_arguments);
+  taas__plab_from_labeling(&plab, lab);
+  int result = taas__plab_check(aaf, &plab, semantics);
+  taas__plab_destroy(&plab);
+  return result;
+}
+
+/**
+ * Returns TRUE iff the given set of arguments is an extension wrt. the
+ * given semantics (one of SEM_*); used for self-checking witnesses.
+ */
+int taas__check_extension(struct AAF* aaf, struct BitSet* set, int semantics){
+  struct PackedLabeling plab;
+  taas__plab_init(&plab, aaf->number_of_arguments);
+  taas__plab_from_set(&plab, aaf, set);
+  int result = taas__plab_check(aaf, &plab, semantics);
+  taas__plab_destroy(&plab);
+  return result;
+}
+
  /* == END FILE ================================================================================================== */
  /* ============================================================================================================== */
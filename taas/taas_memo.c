@@ -0,0 +1,238 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_memo.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Canonical forms of small AAFs with coloured arguments and a
+               memo of results keyed by them, so that isomorphic (parts of)
+               components are solved only once (cf. tasks/task_scc.cpp).
+               The memo can be stored in a sidecar file (cf.
+               taas_sidecar.c) and is then shared by later runs.
+ ============================================================================
+ */
+
+/** AAFs with fewer or more arguments are not memoised */
+#define TAAS_MEMO_MIN_ARGUMENTS 2
+#define TAAS_MEMO_MAX_ARGUMENTS 1024
+/** The maximal number of arguments individualised to break symmetries */
+#define TAAS_MEMO_INDIVIDUALISATIONS 8
+/** The maximal number of integers stored in a memo */
+#define TAAS_MEMO_MAX_SIZE (1 << 22)
+
+/**
+ * A memo of results: keys[k] is a canonical form (cf. memo__canonical())
+ * and results[k] the result stored for it, given as positions wrt. the
+ * canonical order. Entries are found via the hashes of their keys. The
+ * memo may be used by several threads.
+ */
+struct SccMemo{
+  std::mutex lock;
+  std::vector<std::vector<int> > keys;
+  std::vector<std::vector<int> > results;
+  std::unordered_multimap<uint64_t,int> index;
+  /** The number of integers stored */
+  long size;
+  /** Whether entries have been added since the memo was loaded */
+  int changed;
+  SccMemo() : size(0), changed(FALSE) {}
+};
+
+uint64_t memo__mix(uint64_t x){
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+/** Returns the number of different values among the given n colours */
+int memo__number_of_classes(uint64_t* colour, uint64_t* buffer, int n){
+  memcpy(buffer, colour, n * sizeof(uint64_t));
+  std::sort(buffer, buffer + n);
+  return std::unique(buffer, buffer + n) - buffer;
+}
+
+/**
+ * Refines the given colours of the n arguments of the given AAF (in the
+ * layout of memo__canonical()) until the partition into classes of equal
+ * colour is stable: the new colour of an argument combines its colour with
+ * the multisets of the colours of its attackers and attackees. Returns the
+ * number of classes.
+ */
+int memo__refine(int n, int* children_idx, int* children, uint64_t* colour, uint64_t* next, int classes){
+  while(TRUE){
+    for(int i = 0; i < n; i++)
+      next[i] = memo__mix(colour[i]);
+    for(int i = 0; i < n; i++)
+      for(int k = children_idx[i]; k < children_idx[i+1]; k++){
+        next[i] += memo__mix(colour[children[k]] ^ 0x5555555555555555ULL);
+        next[children[k]] += memo__mix(colour[i] ^ 0xAAAAAAAAAAAAAAAAULL);
+      }
+    int refined = memo__number_of_classes(next, colour, n);
+    memcpy(colour, next, n * sizeof(uint64_t));
+    if(refined <= classes)
+      return refined;
+    classes = refined;
+  }
+}
+
+/** Returns the hash of the given key (cf. memo__canonical()) */
+uint64_t memo__hash(std::vector<int>& key){
+  uint64_t hash = 0x9E3779B97F4A7C15ULL;
+  for(size_t k = 0; k < key.size(); k++)
+    hash = memo__mix(hash ^ (uint64_t)(uint32_t) key[k]);
+  return hash;
+}
+
+/**
+ * Computes a canonical form of the AAF with n arguments whose attacks are
+ * given in compressed sparse row layout (the attackees of argument i are
+ * children[children_idx[i]],...,children[children_idx[i+1]-1]) and whose
+ * arguments have the given colours. Arguments are ordered by colour
+ * refinement, where remaining symmetries are broken by individualising a
+ * few arguments and then by the given numbering; order[p] is set to the
+ * argument at position p. The key consists of kind, n, the number of
+ * attacks, the colours, and the attackees of the arguments (all in the
+ * canonical order). Isomorphic AAFs usually get the same key (always if
+ * refinement separates all arguments), and equal keys always imply
+ * isomorphic AAFs. Returns the hash of the key.
+ */
+uint64_t memo__canonical(int n, int* children_idx, int* children, char* colours, int kind, int* order, std::vector<int>& key){
+  uint64_t* colour = (uint64_t*) malloc((n+1) * sizeof(uint64_t));
+  uint64_t* next = (uint64_t*) malloc((n+1) * sizeof(uint64_t));
+  for(int i = 0; i < n; i++)
+    colour[i] = (uint64_t) colours[i];
+  int classes = memo__refine(n, children_idx, children, colour, next, memo__number_of_classes(colour, next, n));
+  for(int round = 0; round < TAAS_MEMO_INDIVIDUALISATIONS && classes < n; round++){
+    // the first argument of the class with the smallest colour among those
+    // with several arguments is given a colour of its own
+    memcpy(next, colour, n * sizeof(uint64_t));
+    std::sort(next, next + n);
+    uint64_t target = 0;
+    for(int i = 0; i+1 < n; i++)
+      if(next[i] == next[i+1]){
+        target = next[i];
+        break;
+      }
+    for(int i = 0; i < n; i++)
+      if(colour[i] == target){
+        colour[i] = memo__mix(colour[i] + 1);
+        break;
+      }
+    classes = memo__refine(n, children_idx, children, colour, next, classes+1);
+  }
+  for(int i = 0; i < n; i++)
+    order[i] = i;
+  std::sort(order, order + n, [&](int a, int b){
+    return colour[a] < colour[b] || (colour[a] == colour[b] && a < b);
+  });
+  // the position of each argument
+  int* position = (int*) next;
+  for(int p = 0; p < n; p++)
+    position[order[p]] = p;
+  key.clear();
+  key.push_back(kind);
+  key.push_back(n);
+  key.push_back(children_idx[n]);
+  for(int p = 0; p < n; p++)
+    key.push_back(colours[order[p]]);
+  for(int p = 0; p < n; p++){
+    int a = order[p];
+    key.push_back(children_idx[a+1] - children_idx[a]);
+    size_t start = key.size();
+    for(int k = children_idx[a]; k < children_idx[a+1]; k++)
+      key.push_back(position[children[k]]);
+    std::sort(key.begin() + start, key.end());
+  }
+  free(colour);
+  free(next);
+  return memo__hash(key);
+}
+
+/**
+ * Looks up the given key (with the given hash) in the given memo; if it
+ * is found, result is set to the stored result and TRUE is returned.
+ */
+int memo__lookup(struct SccMemo* memo, uint64_t hash, std::vector<int>& key, std::vector<int>& result){
+  std::lock_guard<std::mutex> guard(memo->lock);
+  auto range = memo->index.equal_range(hash);
+  for(auto it = range.first; it != range.second; ++it)
+    if(memo->keys[it->second] == key){
+      result = memo->results[it->second];
+      return TRUE;
+    }
+  return FALSE;
+}
+
+/**
+ * Stores the given result for the given key (with the given hash) in the
+ * given memo, unless the memo is full.
+ */
+void memo__store(struct SccMemo* memo, uint64_t hash, std::vector<int>& key, std::vector<int>& result){
+  std::lock_guard<std::mutex> guard(memo->lock);
+  if(memo->size + (long) key.size() + (long) result.size() > TAAS_MEMO_MAX_SIZE)
+    return;
+  memo->index.insert(std::make_pair(hash, (int) memo->keys.size()));
+  memo->keys.push_back(key);
+  memo->results.push_back(result);
+  memo->size += key.size() + result.size();
+  memo->changed = TRUE;
+}
+
+/**
+ * Writes the entries of the given memo to the given file as a sequence of
+ * ints: the number of entries, and for each entry the length of its key,
+ * the key, the length of its result, and the result. Returns the number of
+ * bytes written.
+ */
+int64_t memo__write(FILE* fp, struct SccMemo* memo){
+  int32_t length = memo->keys.size();
+  fwrite(&length, sizeof(int32_t), 1, fp);
+  int64_t size = sizeof(int32_t);
+  for(size_t k = 0; k < memo->keys.size(); k++)
+    for(int part = 0; part < 2; part++){
+      std::vector<int>& values = part == 0 ? memo->keys[k] : memo->results[k];
+      length = values.size();
+      fwrite(&length, sizeof(int32_t), 1, fp);
+      fwrite(values.data(), sizeof(int32_t), length, fp);
+      size += (length + 1) * sizeof(int32_t);
+    }
+  return size;
+}
+
+/**
+ * Adds the entries in the given data (of the given size, as written by
+ * memo__write()) to the given memo. Malformed data is ignored from the
+ * first malformed entry on.
+ */
+void memo__read(struct SccMemo* memo, int32_t* data, int64_t size){
+  int64_t n = size / sizeof(int32_t);
+  if(n < 1)
+    return;
+  int64_t pos = 1;
+  std::vector<int> key, result;
+  for(int32_t e = 0; e < data[0]; e++){
+    if(pos >= n || data[pos] < 3 || data[pos] > n - pos - 2)
+      return;
+    key.assign(data + pos + 1, data + pos + 1 + data[pos]);
+    pos += 1 + data[pos];
+    if(data[pos] < 0 || data[pos] > n - pos - 1)
+      return;
+    result.assign(data + pos + 1, data + pos + 1 + data[pos]);
+    pos += 1 + data[pos];
+    // results are positions of arguments of the key, after a flag
+    if(result.empty())
+      return;
+    for(size_t k = 1; k < result.size(); k++)
+      if(result[k] < 0 || result[k] >= key[1])
+        return;
+    memo__store(memo, memo__hash(key), key, result);
+  }
+  memo->changed = FALSE;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -0,0 +1,514 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_reduct.c
+ Author      : Matthias Thimm
+ Version     : 1.4
+ Copyright   : GPL3
+ Description : Sub-frameworks of AAFs that suffice for solving a task (the
+               undecided core wrt. the grounded labelling, the backward
+               cone of a queried argument, the weakly connected
+               components, and the quotient wrt. structural equivalence),
+               kernels of AAFs (without attacks that do not influence the
+               extensions), and the printing of results (which maps
+               witnesses found on a sub-framework back to the original AAF,
+               or collects the results of components).
+ ============================================================================
+ */
+
+/**
+ * Returns the sub-framework of the given AAF induced by the given arguments
+ * (renumbered in ascending order of their original identifiers), which are
+ * size many.
+ */
+struct AAF* taas__aaf_subframework(struct AAF* aaf, struct BitSet* arguments, int size){
+  int n = aaf->number_of_arguments;
+  struct AAF* sub = (struct AAF*) malloc(sizeof(struct AAF));
+  taas__aaf_init(sub);
+  sub->origin = aaf;
+  sub->origin_ids = (int*) malloc((size+1) * sizeof(int));
+  // the new identifier of each argument (-1 if not in the sub-framework)
+  int* ids = (int*) malloc((n+1) * sizeof(int));
+  int c = 0, m = 0;
+  for(int i = 0; i < n; i++){
+    if(!bitset__get(arguments,i)){
+      ids[i] = -1;
+      continue;
+    }
+    ids[i] = c;
+    sub->origin_ids[c++] = i;
+    for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      if(bitset__get(arguments,aaf->children[k]))
+        m++;
+  }
+  int* attacks = (int*) malloc((2*m+2) * sizeof(int));
+  m = 0;
+  for(c = 0; c < size; c++){
+    int i = sub->origin_ids[c];
+    for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      if(ids[aaf->children[k]] != -1){
+        attacks[m++] = c;
+        attacks[m++] = ids[aaf->children[k]];
+      }
+  }
+  sub->number_of_arguments = size;
+  taas__aaf_build_adjacency(sub, attacks, m/2);
+  free(attacks);
+  free(ids);
+  return sub;
+}
+
+/**
+ * Splits the given AAF into number_of_parts sub-frameworks, where part[i] is
+ * the part of argument i (attacks between different parts are dropped).
+ * Returns the array of sub-frameworks, which is to be freed by the caller.
+ */
+struct AAF** taas__aaf_split(struct AAF* aaf, int* part, int number_of_parts){
+  int n = aaf->number_of_arguments;
+  // the new identifier of each argument within its part
+  int* ids = (int*) malloc((n+1) * sizeof(int));
+  int* sizes = (int*) calloc(number_of_parts+1, sizeof(int));
+  int* number_of_attacks = (int*) calloc(number_of_parts+1, sizeof(int));
+  for(int i = 0; i < n; i++){
+    ids[i] = sizes[part[i]]++;
+    for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      if(part[aaf->children[k]] == part[i])
+        number_of_attacks[part[i]]++;
+  }
+  struct AAF** subs = (struct AAF**) malloc((number_of_parts+1) * sizeof(struct AAF*));
+  int** attacks = (int**) malloc((number_of_parts+1) * sizeof(int*));
+  for(int p = 0; p < number_of_parts; p++){
+    subs[p] = (struct AAF*) malloc(sizeof(struct AAF));
+    taas__aaf_init(subs[p]);
+    subs[p]->origin = aaf;
+    subs[p]->origin_ids = (int*) malloc((sizes[p]+1) * sizeof(int));
+    subs[p]->number_of_arguments = sizes[p];
+    attacks[p] = (int*) malloc((2*number_of_attacks[p]+2) * sizeof(int));
+    number_of_attacks[p] = 0;
+  }
+  for(int i = 0; i < n; i++){
+    int p = part[i];
+    subs[p]->origin_ids[ids[i]] = i;
+    for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      if(part[aaf->children[k]] == p){
+        attacks[p][number_of_attacks[p]++] = ids[i];
+        attacks[p][number_of_attacks[p]++] = ids[aaf->children[k]];
+      }
+  }
+  for(int p = 0; p < number_of_parts; p++){
+    taas__aaf_build_adjacency(subs[p], attacks[p], number_of_attacks[p]/2);
+    free(attacks[p]);
+  }
+  free(attacks);
+  free(number_of_attacks);
+  free(sizes);
+  free(ids);
+  return subs;
+}
+
+/**
+ * Returns the undecided core of the given AAF wrt. its grounded labelling:
+ * the sub-framework of the arguments that are neither in nor out, which
+ * are size many.
+ *
+ * Every complete extension E of the AAF is the union of the grounded
+ * extension and a complete extension of the core (and vice versa), as
+ * grounded arguments are unattacked by the core, out arguments are
+ * attacked by the grounded extension, and no core argument is attacked by
+ * the grounded extension. This bijection preserves set inclusion and
+ * ranges within the core, so it also holds for preferred, stable,
+ * semi-stable and ideal semantics (but not for stage semantics).
+ * Note that the grounded extension of the core is empty.
+ */
+struct AAF* taas__aaf_reduct(struct AAF* aaf, struct Labeling* grounded, int size){
+  struct BitSet* undecided = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__clone(grounded->in, undecided);
+  bitset__or(undecided, grounded->out);
+  // complement (within the arguments)
+  for(int w = 0; w < undecided->num_elements; w++)
+    undecided->data[w] = ~undecided->data[w];
+  undecided->data[undecided->num_elements-1] &= bitset__last_word_mask(undecided);
+  struct AAF* core = taas__aaf_subframework(aaf, undecided, size);
+  core->origin_grounded = grounded;
+  bitset__destroy(undecided);
+  return core;
+}
+
+/**
+ * Returns the backward cone of the given argument (cf.
+ * taas__aaf_backward_cone()) as a sub-framework, or NULL if the cone
+ * contains all arguments.
+ *
+ * As the cone is unattacked, the extensions of the cone are exactly the
+ * restrictions of the extensions of the AAF to the cone wrt. all semantics
+ * satisfying directionality (grounded, complete, preferred), so credulous
+ * and skeptical acceptance of the argument can be decided on the cone.
+ * Witnesses found on the cone are extended to the AAF when printed.
+ */
+struct AAF* taas__aaf_cone(struct AAF* aaf, struct Labeling* grounded, int arg){
+  struct BitSet* cone = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(cone, aaf->number_of_arguments);
+  int size = taas__aaf_backward_cone(aaf, arg, cone);
+  struct AAF* sub = NULL;
+  if(size < aaf->number_of_arguments){
+    sub = taas__aaf_subframework(aaf, cone, size);
+    sub->origin_grounded = grounded;
+    sub->origin_cone = TRUE;
+  }
+  bitset__destroy(cone);
+  return sub;
+}
+
+/**
+ * Returns the identifier of the given argument of the original AAF in the
+ * given sub-framework, or -1 if it is not in the sub-framework.
+ */
+int taas__aaf_reduct_find(struct AAF* sub, int arg){
+  int* end = sub->origin_ids + sub->number_of_arguments;
+  int* pos = std::lower_bound(sub->origin_ids, end, arg);
+  return (pos != end && *pos == arg) ? (int) (pos - sub->origin_ids) : -1;
+}
+
+/** Returns a hash value of the attackers and attackees of the given argument */
+uint64_t taas__aaf_neighbourhood_hash(struct AAF* aaf, int arg){
+  uint64_t hash = 14695981039346656037ULL;
+  for(int k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+    hash = (hash ^ (uint64_t) aaf->parents[k]) * 1099511628211ULL;
+  // separates the attackers from the attackees
+  hash = (hash ^ 0xffffffffULL) * 1099511628211ULL;
+  for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+    hash = (hash ^ (uint64_t) aaf->children[k]) * 1099511628211ULL;
+  return hash;
+}
+
+/** Returns TRUE iff the given arguments have the same attackers and attackees */
+int taas__aaf_equivalent(struct AAF* aaf, int a, int b){
+  int parents = aaf->parents_idx[a+1] - aaf->parents_idx[a];
+  int children = aaf->children_idx[a+1] - aaf->children_idx[a];
+  return parents == aaf->parents_idx[b+1] - aaf->parents_idx[b] &&
+    children == aaf->children_idx[b+1] - aaf->children_idx[b] &&
+    memcmp(aaf->parents + aaf->parents_idx[a], aaf->parents + aaf->parents_idx[b], parents * sizeof(int)) == 0 &&
+    memcmp(aaf->children + aaf->children_idx[a], aaf->children + aaf->children_idx[b], children * sizeof(int)) == 0;
+}
+
+/**
+ * Returns the quotient of the given AAF wrt. structural equivalence, or NULL
+ * if no two arguments are equivalent. Arguments are structurally equivalent
+ * if they have the same attackers and the same attackees; then either none
+ * of them attacks any of them, or all of them attack all of them (including
+ * themselves). In every complete labelling, the label of an argument only
+ * depends on the labels of its attackers, so equivalent arguments are
+ * labelled alike; a conflict-free set containing one of them can be extended
+ * by the others without losing range, so the same holds for stage
+ * extensions. Hence the quotient is the sub-framework induced by one
+ * representative (the smallest) of each class, and its extensions and the
+ * extensions of the AAF correspond one-to-one (so the numbers of extensions
+ * are the same). Witnesses found on the quotient are expanded when printed.
+ */
+struct AAF* taas__aaf_quotient(struct AAF* aaf){
+  int n = aaf->number_of_arguments;
+  uint64_t* hashes = (uint64_t*) malloc((n+1) * sizeof(uint64_t));
+  int* order = (int*) malloc((n+1) * sizeof(int));
+  for(int i = 0; i < n; i++){
+    hashes[i] = taas__aaf_neighbourhood_hash(aaf, i);
+    order[i] = i;
+  }
+  std::sort(order, order + n, [&](int a, int b){
+    return hashes[a] < hashes[b] || (hashes[a] == hashes[b] && a < b);
+  });
+  // the representative of the class of each argument
+  int* representative = (int*) malloc((n+1) * sizeof(int));
+  std::vector<int> group;
+  int number_of_classes = 0;
+  for(int start = 0, end; start < n; start = end){
+    // within a group of equal hash values, classes are found by comparison
+    group.clear();
+    for(end = start; end < n && hashes[order[end]] == hashes[order[start]]; end++){
+      int arg = order[end];
+      representative[arg] = arg;
+      for(size_t g = 0; g < group.size(); g++)
+        if(taas__aaf_equivalent(aaf, group[g], arg)){
+          representative[arg] = group[g];
+          break;
+        }
+      if(representative[arg] == arg){
+        group.push_back(arg);
+        number_of_classes++;
+      }
+    }
+  }
+  free(hashes);
+  free(order);
+  if(number_of_classes == n){
+    free(representative);
+    return NULL;
+  }
+  struct BitSet* representatives = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(representatives, n);
+  bitset__unsetAll(representatives);
+  for(int i = 0; i < n; i++)
+    if(representative[i] == i)
+      bitset__set(representatives, i);
+  struct AAF* quotient = taas__aaf_subframework(aaf, representatives, number_of_classes);
+  bitset__destroy(representatives);
+  // representatives are the smallest members, so they are numbered first
+  quotient->origin_class = representative;
+  for(int i = 0, c = 0; i < n; i++)
+    representative[i] = representative[i] == i ? c++ : representative[representative[i]];
+  return quotient;
+}
+
+/**
+ * Returns TRUE iff the attack from a to b is not in the kernel of the given
+ * AAF wrt. the given semantics (cf. taas__aaf_kernel()).
+ */
+int taas__aaf_kernel_removes(struct AAF* aaf, int semantics, int a, int b){
+  if(a == b || !bitset__get(aaf->loops,a))
+    return FALSE;
+  if(semantics == SEM_ST)
+    return TRUE;
+  if(bitset__get(aaf->loops,b))
+    return TRUE;
+  return semantics == SEM_ADM &&
+    std::binary_search(aaf->children + aaf->children_idx[b], aaf->children + aaf->children_idx[b+1], a);
+}
+
+/**
+ * Reduces the given AAF to its kernel wrt. the given semantics (one of
+ * SEM_ST, SEM_ADM, SEM_CO) by removing every attack (a,b) with a!=b where
+ * - (SEM_ST) a attacks itself,
+ * - (SEM_ADM) a attacks itself and b attacks a or itself,
+ * - (SEM_CO) a and b attack themselves.
+ * A self-attacking argument is never in a conflict-free set and never
+ * defended by one, so the kernel has the same stable (and stage),
+ * admissible (and preferred, semi-stable, ideal), resp. complete extensions
+ * as the AAF (cf. Oikarinen, Woltran. Characterizing strong equivalence for
+ * argumentation frameworks. AIJ 175, 2011). The AAF must own its adjacency
+ * and its components and matrix must not be computed yet. Returns the
+ * number of removed attacks.
+ */
+int taas__aaf_kernel(struct AAF* aaf, int semantics){
+  int n = aaf->number_of_arguments;
+  if(bitset__next_set_bit(aaf->loops,0) == -1)
+    return 0;
+  // self-check (only if compiled without NDEBUG)
+  assert(aaf->mapping == NULL && aaf->scc == NULL && aaf->matrix_parents == NULL);
+  // decide on the children side first, as rows of children are searched
+  char* removed = (char*) malloc((aaf->number_of_attacks+1) * sizeof(char));
+  for(int a = 0; a < n; a++)
+    for(int k = aaf->children_idx[a]; k < aaf->children_idx[a+1]; k++)
+      removed[k] = (char) taas__aaf_kernel_removes(aaf, semantics, a, aaf->children[k]);
+  int m = 0;
+  for(int b = 0; b < n; b++){
+    int start = aaf->parents_idx[b];
+    aaf->parents_idx[b] = m;
+    for(int k = start; k < aaf->parents_idx[b+1]; k++)
+      if(!taas__aaf_kernel_removes(aaf, semantics, aaf->parents[k], b))
+        aaf->parents[m++] = aaf->parents[k];
+  }
+  aaf->parents_idx[n] = m;
+  m = 0;
+  for(int a = 0; a < n; a++){
+    int start = aaf->children_idx[a];
+    aaf->children_idx[a] = m;
+    for(int k = start; k < aaf->children_idx[a+1]; k++)
+      if(!removed[k])
+        aaf->children[m++] = aaf->children[k];
+  }
+  aaf->children_idx[n] = m;
+  free(removed);
+  int number_of_removed = aaf->number_of_attacks - m;
+  aaf->number_of_attacks = m;
+  for(int b = 0; b < n; b++){
+    aaf->number_of_attackers[b] = aaf->parents_idx[b+1] - aaf->parents_idx[b];
+    if(aaf->number_of_attackers[b] == 0)
+      bitset__set(aaf->initial,b);
+  }
+  return number_of_removed;
+}
+
+/**
+ * Returns the restriction of the given labelling (of the original AAF) to
+ * the given sub-framework.
+ */
+struct Labeling* taas__lab_reduct(struct Labeling* lab, struct AAF* sub){
+  struct Labeling* result = (struct Labeling*) malloc(sizeof(struct Labeling));
+  taas__lab_init(result, FALSE);
+  bitset__init(result->in, sub->number_of_arguments);
+  bitset__unsetAll(result->in);
+  bitset__init(result->out, sub->number_of_arguments);
+  bitset__unsetAll(result->out);
+  for(int i = 0; i < sub->number_of_arguments; i++){
+    if(bitset__get(lab->in, sub->origin_ids[i]))
+      bitset__set(result->in, i);
+    else if(bitset__get(lab->out, sub->origin_ids[i]))
+      bitset__set(result->out, i);
+  }
+  return result;
+}
+
+/**
+ * Extends the given admissible set to the least complete extension
+ * containing it, by propagating labels as for the grounded extension
+ * (cf. taas__compute_grounded()).
+ */
+void taas__compute_completion(struct AAF* aaf, struct BitSet* set){
+  int n = aaf->number_of_arguments;
+  struct BitSet* out = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(out, n);
+  bitset__unsetAll(out);
+  // the number of attackers of each argument that are not (yet) out
+  int* attackers = (int*) malloc((n+1) * sizeof(int));
+  memcpy(attackers, aaf->number_of_attackers, n * sizeof(int));
+  int* queue = (int*) malloc((n+1) * sizeof(int));
+  int head = 0, tail = 0;
+  for(int a = bitset__next_set_bit(set,0); a != -1 ; a = bitset__next_set_bit(set, a+1))
+    queue[tail++] = a;
+  // unattacked arguments are defended by any set
+  for(int a = bitset__next_set_bit(aaf->initial,0); a != -1 ; a = bitset__next_set_bit(aaf->initial, a+1))
+    if(!bitset__get(set,a)){
+      bitset__set(set,a);
+      queue[tail++] = a;
+    }
+  while(head < tail){
+    int arg = queue[head++];
+    for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++){
+      int child = aaf->children[k];
+      if(bitset__get(out,child))
+        continue;
+      bitset__set(out,child);
+      for(int k2 = aaf->children_idx[child]; k2 < aaf->children_idx[child+1]; k2++){
+        int child2 = aaf->children[k2];
+        if(--attackers[child2] == 0 && !bitset__get(set,child2)){
+          bitset__set(set,child2);
+          queue[tail++] = child2;
+        }
+      }
+    }
+  }
+  bitset__destroy(out);
+  free(attackers);
+  free(queue);
+}
+
+/**
+ * The results of solving a union of components of an AAF on its own (cf.
+ * taas__solve_components()), which are collected instead of printed.
+ */
+struct ComponentResult{
+  // the union of the witnesses of all components (as arguments of the
+  // original AAF), shared by all components and set atomically
+  struct BitSet* witness;
+  // TRUE iff a witness was found
+  int has_witness;
+  // TRUE iff there is no extension (for SE problems)
+  int no_extension;
+  // the number of extensions (for CE problems, NULL until known)
+  struct BigNum* count;
+};
+
+/**
+ * Checks the given witness (a set of arguments of the given AAF): if the
+ * AAF is an undecided core, the witness mapped to the original AAF must be
+ * complete (all semantics the core is used for are complete-based),
+ * otherwise it must be conflict-free.
+ */
+int taas__check_witness(struct AAF* aaf, struct BitSet* set){
+  if(aaf->origin == NULL)
+    return taas__check_extension(aaf, set, SEM_CF);
+  struct BitSet* extension = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__clone(aaf->origin_grounded->in, extension);
+  for(int i = bitset__next_set_bit(set,0); i != -1; i = bitset__next_set_bit(set,i+1))
+    bitset__set(extension, aaf->origin_ids[i]);
+  int result = taas__check_extension(aaf->origin, extension, SEM_CO);
+  bitset__destroy(extension);
+  return result;
+}
+
+/**
+ * Prints the given witness (a set of arguments of the given AAF) in
+ * ICCMA23 style. If the AAF is an undecided core, the grounded extension
+ * of the original AAF is printed as well; if it is a cone, the witness
+ * (which must be admissible) is first extended to the least complete
+ * extension of the original AAF containing it; if it is a quotient, the
+ * witness is expanded by all equivalent arguments; if it is a union of
+ * components, the witness is collected.
+ */
+void taas__print_witness(struct AAF* aaf, struct BitSet* set){
+  if(aaf->origin_result != NULL){
+    // self-check (only if compiled without NDEBUG)
+    assert(taas__check_extension(aaf,set,SEM_CF));
+    for(int i = bitset__next_set_bit(set,0); i != -1; i = bitset__next_set_bit(set,i+1))
+      bitset__test_and_set_atomic(aaf->origin_result->witness, aaf->origin_ids[i]);
+    aaf->origin_result->has_witness = TRUE;
+    return;
+  }
+  if(aaf->origin_class != NULL){
+    struct BitSet* extension = (struct BitSet*) malloc(sizeof(struct BitSet));
+    bitset__init(extension, aaf->origin->number_of_arguments);
+    bitset__unsetAll(extension);
+    for(int i = 0; i < aaf->origin->number_of_arguments; i++)
+      if(bitset__get(set, aaf->origin_class[i]))
+        bitset__set(extension, i);
+    taas__print_witness(aaf->origin, extension);
+    bitset__destroy(extension);
+    return;
+  }
+  if(aaf->origin != NULL && aaf->origin_cone){
+    struct BitSet* extension = (struct BitSet*) malloc(sizeof(struct BitSet));
+    bitset__init(extension, aaf->origin->number_of_arguments);
+    bitset__unsetAll(extension);
+    for(int i = bitset__next_set_bit(set,0); i != -1; i = bitset__next_set_bit(set,i+1))
+      bitset__set(extension, aaf->origin_ids[i]);
+    taas__compute_completion(aaf->origin, extension);
+    taas__print_witness(aaf->origin, extension);
+    bitset__destroy(extension);
+    return;
+  }
+  // self-check (only if compiled without NDEBUG)
+  assert(taas__check_witness(aaf,set));
+  printf("w ");
+  if(aaf->origin != NULL)
+    for(int i = bitset__next_set_bit(aaf->origin_grounded->in,0); i != -1; i = bitset__next_set_bit(aaf->origin_grounded->in,i+1))
+      printf("%s ", taas__aaf_argument_name(aaf->origin,i));
+  for(int i = bitset__next_set_bit(set,0); i != -1; i = bitset__next_set_bit(set,i+1))
+    printf("%s ", taas__aaf_argument_name(aaf,i));
+  printf("\n");
+}
+
+/**
+ * Prints that there is no extension (for SE problems), or collects this
+ * (cf. taas__print_witness()).
+ */
+void taas__print_no_extension(struct AAF* aaf){
+  if(aaf->origin_result != NULL)
+    aaf->origin_result->no_extension = TRUE;
+  else printf("NO\n");
+}
+
+/**
+ * Prints the number of extensions (for CE problems), or collects it (cf.
+ * taas__print_witness()); the number is destroyed resp. taken over.
+ */
+void taas__print_count_bignum(struct AAF* aaf, struct BigNum* count){
+  if(aaf->origin_result != NULL)
+    aaf->origin_result->count = count;
+  else{
+    bignum__print(count);
+    printf("\n");
+    bignum__destroy(count);
+  }
+}
+
+/** Prints the number of extensions (for CE problems), or collects it */
+void taas__print_count(struct AAF* aaf, long count){
+  struct BigNum* num = (struct BigNum*) malloc(sizeof(struct BigNum));
+  bignum__init(num, count);
+  taas__print_count_bignum(aaf, num);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
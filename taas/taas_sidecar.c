@@ -0,0 +1,222 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_sidecar.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : A sidecar file caching the results of analysing an AAF that
+               depend on the framework only (grounded labelling, strongly
+               connected components, structural features), so that
+               repeated queries on the same instance do not recompute them,
+               and the memo of results of components (cf. taas_memo.c),
+               which grows with every run. Sidecar files are keyed by a
+               hash of the framework.
+ ============================================================================
+ */
+
+#define TAAS_SIDECAR_MAGIC "TAASSCR"
+#define TAAS_SIDECAR_VERSION 2
+
+/**
+ * The header of a sidecar file; sections are stored at the given offsets
+ * (as in snapshots, cf. taas_snapshot.c).
+ */
+struct SidecarHeader{
+  char magic[8];
+  uint32_t version;
+  /** The number of bits of a bitset word */
+  uint32_t word_bits;
+  /** The hash of the AAF (cf. taas__aaf_hash()) */
+  uint64_t key;
+  int64_t number_of_arguments;
+  int64_t number_of_attacks;
+  int64_t number_of_sccs;
+  /** Structural features of the AAF */
+  struct GraphStats stats;
+  /** The size of the whole file */
+  int64_t size;
+  /** Section offsets */
+  int64_t grounded_in;
+  int64_t grounded_out;
+  int64_t scc;
+  int64_t scc_idx;
+  int64_t scc_members;
+  /** The memo is the last section (cf. memo__write()) */
+  int64_t memo;
+  int64_t memo_size;
+};
+
+/**
+ * Writes the memo of the given AAF (or an empty one) as the last section
+ * of the sidecar file at offset pos and sets its offset and size in the
+ * given header.
+ */
+void taas__sidecar_write_memo(FILE* fp, struct SidecarHeader* header, int64_t pos, struct AAF* aaf){
+  header->memo = pos;
+  if(aaf->scc_memo != NULL)
+    header->memo_size = memo__write(fp, aaf->scc_memo);
+  else{
+    int32_t empty = 0;
+    fwrite(&empty, sizeof(int32_t), 1, fp);
+    header->memo_size = sizeof(int32_t);
+  }
+  header->size = pos + header->memo_size;
+}
+
+/**
+ * Writes the sidecar file for the given AAF and its grounded labelling;
+ * the file is written under a temporary name first and then renamed, so
+ * that concurrent runs never see a partially written sidecar.
+ */
+void taas__writeFile_sidecar(char* path, struct AAF* aaf, struct Labeling* grounded){
+  taas__aaf_compute_sccs(aaf);
+  char* tmp_path = (char*) malloc(strlen(path) + 32);
+  sprintf(tmp_path, "%s.%d.tmp", path, (int) getpid());
+  FILE* fp = fopen(tmp_path,"wb");
+  if(fp == NULL){
+    // a sidecar is just a cache, so failing to write it is not an error
+    free(tmp_path);
+    return;
+  }
+  int n = aaf->number_of_arguments;
+  struct SidecarHeader header;
+  memset(&header, 0, sizeof(struct SidecarHeader));
+  memcpy(header.magic, TAAS_SIDECAR_MAGIC, 8);
+  header.version = TAAS_SIDECAR_VERSION;
+  header.word_bits = WORD_BITS;
+  header.key = taas__aaf_hash(aaf);
+  header.number_of_arguments = n;
+  header.number_of_attacks = aaf->number_of_attacks;
+  header.number_of_sccs = aaf->number_of_sccs;
+  taas__aaf_compute_stats(aaf, &header.stats);
+  fwrite(&header, 1, sizeof(struct SidecarHeader), fp);
+  int64_t pos = sizeof(struct SidecarHeader);
+  header.grounded_in = taas__snapshot_write_section(fp, &pos, grounded->in->data, grounded->in->num_elements * sizeof(bitset_word));
+  header.grounded_out = taas__snapshot_write_section(fp, &pos, grounded->out->data, grounded->out->num_elements * sizeof(bitset_word));
+  header.scc = taas__snapshot_write_section(fp, &pos, aaf->scc, n * sizeof(int));
+  header.scc_idx = taas__snapshot_write_section(fp, &pos, aaf->scc_idx, (aaf->number_of_sccs+1) * sizeof(int));
+  header.scc_members = taas__snapshot_write_section(fp, &pos, aaf->scc_members, n * sizeof(int));
+  taas__sidecar_write_memo(fp, &header, pos, aaf);
+  fseek(fp, 0, SEEK_SET);
+  fwrite(&header, 1, sizeof(struct SidecarHeader), fp);
+  if(fclose(fp) != 0 || rename(tmp_path, path) != 0)
+    unlink(tmp_path);
+  free(tmp_path);
+}
+
+/** Returns TRUE iff the section [offset,offset+size) lies within the sidecar file */
+int taas__sidecar_check_section(struct SidecarHeader* header, int64_t offset, int64_t size){
+  return offset >= (int64_t) sizeof(struct SidecarHeader) && offset % 8 == 0 && size >= 0 && offset + size <= header->size;
+}
+
+/**
+ * Reads the sidecar file for the given AAF: if it exists and belongs to
+ * the AAF, the grounded labelling is initialised from it, the components
+ * of the AAF point into the (mapped) file, the memo of the AAF (if any)
+ * is filled, and TRUE is returned.
+ * Otherwise FALSE is returned and nothing is changed.
+ */
+int taas__readFile_sidecar(char* path, struct AAF* aaf, struct Labeling* grounded){
+  int fd = open(path, O_RDONLY);
+  if(fd < 0)
+    return FALSE;
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(struct SidecarHeader)){
+    close(fd);
+    return FALSE;
+  }
+  char* data = (char*) mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED)
+    return FALSE;
+  struct SidecarHeader* header = (struct SidecarHeader*) data;
+  int64_t n = aaf->number_of_arguments;
+  int64_t words = n/WORD_BITS+1;
+  if(memcmp(header->magic, TAAS_SIDECAR_MAGIC, 8) != 0 ||
+      header->version != TAAS_SIDECAR_VERSION ||
+      header->word_bits != WORD_BITS ||
+      header->size != st.st_size ||
+      header->number_of_arguments != n ||
+      header->number_of_attacks != aaf->number_of_attacks ||
+      header->number_of_sccs < 0 || header->number_of_sccs > n ||
+      !taas__sidecar_check_section(header, header->grounded_in, words * sizeof(bitset_word)) ||
+      !taas__sidecar_check_section(header, header->grounded_out, words * sizeof(bitset_word)) ||
+      !taas__sidecar_check_section(header, header->scc, n * sizeof(int)) ||
+      !taas__sidecar_check_section(header, header->scc_idx, (header->number_of_sccs+1) * sizeof(int)) ||
+      !taas__sidecar_check_section(header, header->scc_members, n * sizeof(int)) ||
+      !taas__sidecar_check_section(header, header->memo, header->memo_size) ||
+      header->memo + header->memo_size != header->size ||
+      header->key != taas__aaf_hash(aaf)){
+    munmap(data, st.st_size);
+    return FALSE;
+  }
+  // the grounded labelling is copied as it may be modified by the solver
+  bitset__init(grounded->in, n);
+  memcpy(grounded->in->data, data + header->grounded_in, words * sizeof(bitset_word));
+  bitset__init(grounded->out, n);
+  memcpy(grounded->out->data, data + header->grounded_out, words * sizeof(bitset_word));
+  if(aaf->scc_memo != NULL)
+    memo__read(aaf->scc_memo, (int32_t*) (data + header->memo), header->memo_size);
+  if(aaf->scc == NULL){
+    aaf->sidecar = data;
+    aaf->sidecar_size = st.st_size;
+    aaf->number_of_sccs = header->number_of_sccs;
+    aaf->scc = (int*) (data + header->scc);
+    aaf->scc_idx = (int*) (data + header->scc_idx);
+    aaf->scc_members = (int*) (data + header->scc_members);
+  }else munmap(data, st.st_size);
+  return TRUE;
+}
+
+/**
+ * Replaces the memo in the sidecar file for the given AAF by the memo of
+ * the AAF if entries have been added to it (e.g. by solving components),
+ * so that later runs can reuse them; the rest of the file is kept.
+ */
+void taas__writeFile_sidecar_memo(char* path, struct AAF* aaf){
+  if(aaf->scc_memo == NULL || !aaf->scc_memo->changed)
+    return;
+  FILE* in = fopen(path,"rb");
+  if(in == NULL)
+    return;
+  struct SidecarHeader header;
+  if(fread(&header, 1, sizeof(struct SidecarHeader), in) != sizeof(struct SidecarHeader) ||
+      memcmp(header.magic, TAAS_SIDECAR_MAGIC, 8) != 0 ||
+      header.version != TAAS_SIDECAR_VERSION ||
+      header.key != taas__aaf_hash(aaf) ||
+      !taas__sidecar_check_section(&header, header.memo, 0)){
+    fclose(in);
+    return;
+  }
+  char* tmp_path = (char*) malloc(strlen(path) + 32);
+  sprintf(tmp_path, "%s.%d.tmp", path, (int) getpid());
+  FILE* fp = fopen(tmp_path,"wb");
+  if(fp == NULL){
+    fclose(in);
+    free(tmp_path);
+    return;
+  }
+  // everything before the memo is copied
+  fwrite(&header, 1, sizeof(struct SidecarHeader), fp);
+  char buffer[1 << 16];
+  int ok = TRUE;
+  for(int64_t pos = sizeof(struct SidecarHeader); pos < header.memo && ok; ){
+    size_t size = std::min((int64_t) sizeof(buffer), header.memo - pos);
+    ok = fread(buffer, 1, size, in) == size && fwrite(buffer, 1, size, fp) == size;
+    pos += size;
+  }
+  fclose(in);
+  taas__sidecar_write_memo(fp, &header, header.memo, aaf);
+  fseek(fp, 0, SEEK_SET);
+  fwrite(&header, 1, sizeof(struct SidecarHeader), fp);
+  if(fclose(fp) != 0 || !ok || rename(tmp_path, path) != 0)
+    unlink(tmp_path);
+  free(tmp_path);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
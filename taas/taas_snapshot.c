@@ -0,0 +1,233 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_snapshot.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : A binary snapshot format for AAFs that can be memory-mapped
+               directly, so that loading takes constant time (apart from
+               page faults). Snapshots use the native byte order.
+ ============================================================================
+ */
+
+#define TAAS_SNAPSHOT_MAGIC "TAASAAF"
+#define TAAS_SNAPSHOT_VERSION 2
+
+/**
+ * The header of a snapshot; all sections are stored at the given offsets
+ * (from the start of the file) and are aligned to 8 bytes.
+ */
+struct SnapshotHeader{
+  char magic[8];
+  uint32_t version;
+  /** The number of bits of a bitset word */
+  uint32_t word_bits;
+  /** The hash of the AAF (cf. taas__aaf_hash()) */
+  uint64_t key;
+  int64_t number_of_arguments;
+  int64_t number_of_attacks;
+  /** The size of the names section (0 if arguments are unnamed) */
+  int64_t names_length;
+  /** The size of the whole file */
+  int64_t size;
+  /** Section offsets */
+  int64_t children_idx;
+  int64_t children;
+  int64_t parents_idx;
+  int64_t parents;
+  int64_t number_of_attackers;
+  int64_t initial;
+  int64_t loops;
+  int64_t names_idx;
+  int64_t names;
+};
+
+/**
+ * Writes a section of the snapshot padded to 8 bytes; pos is the current
+ * offset and is advanced accordingly. Returns the offset of the section.
+ */
+int64_t taas__snapshot_write_section(FILE* fp, int64_t* pos, const void* data, size_t size){
+  static const char padding[8] = {0};
+  int64_t offset = *pos;
+  if(size > 0)
+    fwrite(data, 1, size, fp);
+  fwrite(padding, 1, (8 - size % 8) % 8, fp);
+  *pos += size + (8 - size % 8) % 8;
+  return offset;
+}
+
+/**
+ * Writes a snapshot of the given AAF to the given path (named arguments
+ * are included); the file is written under a temporary name first and
+ * then renamed, so that concurrent runs never see a partial snapshot.
+ */
+void taas__writeFile_bin(char* path, struct AAF* aaf){
+  char* tmp_path = (char*) malloc(strlen(path) + 32);
+  sprintf(tmp_path, "%s.%d.tmp", path, (int) getpid());
+  FILE* fp = fopen(tmp_path,"wb");
+  if(fp == NULL){
+    fprintf(stderr, "cannot write snapshot %s\n", path);
+    exit(1);
+  }
+  int n = aaf->number_of_arguments;
+  struct SnapshotHeader header;
+  memset(&header, 0, sizeof(struct SnapshotHeader));
+  memcpy(header.magic, TAAS_SNAPSHOT_MAGIC, 8);
+  header.version = TAAS_SNAPSHOT_VERSION;
+  header.word_bits = WORD_BITS;
+  header.key = taas__aaf_hash(aaf);
+  header.number_of_arguments = n;
+  header.number_of_attacks = aaf->number_of_attacks;
+  // the header is rewritten once all offsets are known
+  fwrite(&header, 1, sizeof(struct SnapshotHeader), fp);
+  int64_t pos = sizeof(struct SnapshotHeader);
+  int m = aaf->number_of_attacks;
+  header.children_idx = taas__snapshot_write_section(fp, &pos, aaf->children_idx, (n+1) * sizeof(int));
+  header.children = taas__snapshot_write_section(fp, &pos, aaf->children, m * sizeof(int));
+  header.parents_idx = taas__snapshot_write_section(fp, &pos, aaf->parents_idx, (n+1) * sizeof(int));
+  header.parents = taas__snapshot_write_section(fp, &pos, aaf->parents, m * sizeof(int));
+  header.number_of_attackers = taas__snapshot_write_section(fp, &pos, aaf->number_of_attackers, n * sizeof(int));
+  header.initial = taas__snapshot_write_section(fp, &pos, aaf->initial->data, aaf->initial->num_elements * sizeof(bitset_word));
+  header.loops = taas__snapshot_write_section(fp, &pos, aaf->loops->data, aaf->loops->num_elements * sizeof(bitset_word));
+  if(aaf->names != NULL && n > 0){
+    header.names_length = aaf->names_idx[n-1] + strlen(aaf->names + aaf->names_idx[n-1]) + 1;
+    header.names_idx = taas__snapshot_write_section(fp, &pos, aaf->names_idx, n * sizeof(size_t));
+    header.names = taas__snapshot_write_section(fp, &pos, aaf->names, header.names_length);
+  }
+  header.size = pos;
+  fseek(fp, 0, SEEK_SET);
+  fwrite(&header, 1, sizeof(struct SnapshotHeader), fp);
+  if(fclose(fp) != 0 || rename(tmp_path, path) != 0){
+    unlink(tmp_path);
+    fprintf(stderr, "cannot write snapshot %s\n", path);
+    exit(1);
+  }
+  free(tmp_path);
+}
+
+/** Returns TRUE iff the section [offset,offset+size) lies within the snapshot */
+int taas__snapshot_check_section(struct SnapshotHeader* header, int64_t offset, int64_t size){
+  return offset >= (int64_t) sizeof(struct SnapshotHeader) && offset % 8 == 0 && size >= 0 && offset + size <= header->size;
+}
+
+/**
+ * Returns TRUE iff the arrays of the given AAF (loaded from a snapshot
+ * with a names section of the given size) are consistent, so that loops
+ * over them stay within bounds: the index arrays are monotone from 0 to
+ * the number of attacks, rows are sorted lists of arguments, the numbers
+ * of attackers match the rows of parents, bitsets have no bits beyond the
+ * last argument, and names are NUL-terminated within their section.
+ */
+int taas__snapshot_check(struct AAF* aaf, int64_t names_length){
+  int n = aaf->number_of_arguments;
+  int m = aaf->number_of_attacks;
+  int* idx[2] = {aaf->children_idx, aaf->parents_idx};
+  int* adj[2] = {aaf->children, aaf->parents};
+  for(int a = 0; a < 2; a++){
+    if(idx[a][0] != 0 || idx[a][n] != m)
+      return FALSE;
+    for(int i = 0; i < n; i++){
+      if(idx[a][i+1] < idx[a][i] || idx[a][i+1] > m)
+        return FALSE;
+      for(int k = idx[a][i]; k < idx[a][i+1]; k++)
+        if(adj[a][k] < 0 || adj[a][k] >= n || (k > idx[a][i] && adj[a][k] <= adj[a][k-1]))
+          return FALSE;
+    }
+  }
+  for(int i = 0; i < n; i++)
+    if(aaf->number_of_attackers[i] != aaf->parents_idx[i+1] - aaf->parents_idx[i])
+      return FALSE;
+  struct BitSet* bitsets[2] = {aaf->initial, aaf->loops};
+  for(int b = 0; b < 2; b++)
+    if(bitsets[b]->data[bitsets[b]->num_elements-1] & ~bitset__last_word_mask(bitsets[b]))
+      return FALSE;
+  if(names_length > 0){
+    if(aaf->names[names_length-1] != '\0')
+      return FALSE;
+    for(int i = 0; i < n; i++)
+      if(aaf->names_idx[i] >= (size_t) names_length)
+        return FALSE;
+  }
+  return TRUE;
+}
+
+/**
+ * Loads a snapshot by mapping it into memory; the arrays of the AAF
+ * point directly into the (private) mapping.
+ */
+void taas__readFile_bin(char* path, struct AAF* aaf){
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  if(fd < 0 || fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(struct SnapshotHeader)){
+    fprintf(stderr, "cannot read snapshot %s\n", path);
+    exit(1);
+  }
+  char* data = (char*) mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED){
+    fprintf(stderr, "cannot read snapshot %s\n", path);
+    exit(1);
+  }
+  struct SnapshotHeader* header = (struct SnapshotHeader*) data;
+  int64_t n = header->number_of_arguments;
+  int64_t m = header->number_of_attacks;
+  int64_t words = n/WORD_BITS+1;
+  if(memcmp(header->magic, TAAS_SNAPSHOT_MAGIC, 8) != 0 ||
+      header->version != TAAS_SNAPSHOT_VERSION ||
+      header->word_bits != WORD_BITS ||
+      header->size != st.st_size ||
+      n < 0 || n > INT_MAX || m < 0 || m > INT_MAX ||
+      !taas__snapshot_check_section(header, header->children_idx, (n+1) * sizeof(int)) ||
+      !taas__snapshot_check_section(header, header->children, m * sizeof(int)) ||
+      !taas__snapshot_check_section(header, header->parents_idx, (n+1) * sizeof(int)) ||
+      !taas__snapshot_check_section(header, header->parents, m * sizeof(int)) ||
+      !taas__snapshot_check_section(header, header->number_of_attackers, n * sizeof(int)) ||
+      !taas__snapshot_check_section(header, header->initial, words * sizeof(bitset_word)) ||
+      !taas__snapshot_check_section(header, header->loops, words * sizeof(bitset_word)) ||
+      (header->names_length > 0 &&
+        (!taas__snapshot_check_section(header, header->names_idx, n * sizeof(size_t)) ||
+         !taas__snapshot_check_section(header, header->names, header->names_length)))){
+    fprintf(stderr, "%s is not a valid snapshot\n", path);
+    exit(1);
+  }
+  aaf->mapping = data;
+  aaf->mapping_size = st.st_size;
+  // files keyed by the AAF (e.g. sidecar files) are checked without
+  // another pass over it
+  aaf->hash = header->key;
+  aaf->number_of_arguments = n;
+  aaf->number_of_attacks = m;
+  aaf->children_idx = (int*) (data + header->children_idx);
+  aaf->children = (int*) (data + header->children);
+  aaf->parents_idx = (int*) (data + header->parents_idx);
+  aaf->parents = (int*) (data + header->parents);
+  aaf->number_of_attackers = (int*) (data + header->number_of_attackers);
+  aaf->initial = (struct BitSet*) malloc(sizeof(struct BitSet));
+  aaf->initial->data = (bitset_word*) (data + header->initial);
+  aaf->initial->length = n;
+  aaf->initial->num_elements = words;
+  aaf->loops = (struct BitSet*) malloc(sizeof(struct BitSet));
+  aaf->loops->data = (bitset_word*) (data + header->loops);
+  aaf->loops->length = n;
+  aaf->loops->num_elements = words;
+  // arguments are looked up on demand (cf. taas__aaf_find_argument())
+  aaf->arguments2ids = NULL;
+  if(header->names_length > 0){
+    aaf->names_idx = (size_t*) (data + header->names_idx);
+    aaf->names = data + header->names;
+  }else{
+    aaf->names_idx = NULL;
+    aaf->names = NULL;
+  }
+  if(!taas__snapshot_check(aaf, header->names_length)){
+    fprintf(stderr, "%s is not a valid snapshot\n", path);
+    exit(1);
+  }
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
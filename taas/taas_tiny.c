@@ -0,0 +1,264 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_tiny.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : An exhaustive engine for AAFs with at most 64 arguments,
+               where sets of arguments are machine words: extensions are
+               enumerated by a depth-first search over the arguments that
+               checks the conditions of the semantics with a few bit
+               operations per node. For such small AAFs (or components)
+               this is much faster than setting up a SAT solver.
+ ============================================================================
+ */
+
+/** The maximal number of arguments of a tiny AAF */
+#define TAAS_TINY_MAX_ARGUMENTS 64
+/** The number of search nodes after which the search is given up */
+#define TAAS_TINY_BUDGET (1 << 16)
+
+#define TINY_BIT(i) (((uint64_t) 1) << (i))
+
+#define TINY_CONTINUE 1
+#define TINY_STOP 0
+#define TINY_ABORT -1
+
+/**
+ * An AAF with at most 64 arguments, where the attackers and the attacked
+ * arguments of each argument are given as bit masks. Extensions may be
+ * restricted to contain all required and no forbidden arguments.
+ */
+struct TinyAAF{
+  int number_of_arguments;
+  uint64_t all;
+  uint64_t loops;
+  uint64_t parents[TAAS_TINY_MAX_ARGUMENTS];
+  uint64_t children[TAAS_TINY_MAX_ARGUMENTS];
+  uint64_t required;
+  uint64_t forbidden;
+};
+
+/** Initialises the given tiny AAF with the given number of arguments and no attacks */
+void tiny__init(struct TinyAAF* t, int number_of_arguments){
+  memset(t, 0, sizeof(struct TinyAAF));
+  t->number_of_arguments = number_of_arguments;
+  t->all = number_of_arguments == 64 ? ~((uint64_t) 0) : TINY_BIT(number_of_arguments) - 1;
+}
+
+void tiny__add_attack(struct TinyAAF* t, int a, int b){
+  t->children[a] |= TINY_BIT(b);
+  t->parents[b] |= TINY_BIT(a);
+  if(a == b)
+    t->loops |= TINY_BIT(a);
+}
+
+/** Initialises the given tiny AAF with the given AAF (with at most 64 arguments) */
+void tiny__from_aaf(struct TinyAAF* t, struct AAF* aaf){
+  tiny__init(t, aaf->number_of_arguments);
+  for(int a = 0; a < aaf->number_of_arguments; a++)
+    for(int k = aaf->children_idx[a]; k < aaf->children_idx[a+1]; k++)
+      tiny__add_attack(t, a, aaf->children[k]);
+}
+
+/** Returns the arguments attacked by the given set */
+uint64_t tiny__attacked(struct TinyAAF* t, uint64_t set){
+  uint64_t result = 0;
+  for(; set != 0; set &= set - 1)
+    result |= t->children[__builtin_ctzll(set)];
+  return result;
+}
+
+/** Returns the attackers of the given set */
+uint64_t tiny__attackers(struct TinyAAF* t, uint64_t set){
+  uint64_t result = 0;
+  for(; set != 0; set &= set - 1)
+    result |= t->parents[__builtin_ctzll(set)];
+  return result;
+}
+
+/** Returns the arguments all of whose attackers are in the given set */
+uint64_t tiny__defended(struct TinyAAF* t, uint64_t attacked){
+  uint64_t result = 0;
+  for(int a = 0; a < t->number_of_arguments; a++)
+    if((t->parents[a] & ~attacked) == 0)
+      result |= TINY_BIT(a);
+  return result;
+}
+
+/**
+ * Decides argument i (and the following ones) of the search for extensions
+ * wrt. the given semantics (one of SEM_*), where in is the set of arguments
+ * decided to be in, attacked are the arguments attacked by in, and conflict
+ * are the arguments that cannot be added to in without a conflict. A branch
+ * is cut as soon as an argument decided to be out is defended (SEM_CO,
+ * SEM_ST) or an attacker of in (or, for SEM_ST, an argument decided to be
+ * out) is not attacked by in and cannot be attacked any more by the
+ * remaining candidates. Returns TINY_STOP if visit() returned FALSE and
+ * TINY_ABORT if the budget is exhausted.
+ */
+template<typename F> int tiny__search(struct TinyAAF* t, int semantics, int i, uint64_t in, uint64_t attacked,
+        uint64_t conflict, long* budget, F& visit){
+  if(--(*budget) < 0)
+    return TINY_ABORT;
+  int n = t->number_of_arguments;
+  uint64_t decided = i == 64 ? t->all : TINY_BIT(i) - 1;
+  if(semantics != SEM_CF){
+    uint64_t candidates = t->all & ~decided & ~conflict & ~t->forbidden;
+    uint64_t attackable = attacked | tiny__attacked(t, candidates);
+    if(tiny__attackers(t, in) & ~attackable)
+      return TINY_CONTINUE;
+    if(semantics >= SEM_CO && (tiny__defended(t, attacked) & decided & ~in))
+      return TINY_CONTINUE;
+    if(semantics == SEM_ST && (decided & ~in & ~attackable))
+      return TINY_CONTINUE;
+  }
+  // all conditions are checked completely once all arguments are decided
+  if(i == n)
+    return visit(in) ? TINY_CONTINUE : TINY_STOP;
+  uint64_t b = TINY_BIT(i);
+  if(!(conflict & b) && !(t->forbidden & b)){
+    int result = tiny__search(t, semantics, i+1, in | b, attacked | t->children[i],
+        conflict | t->children[i] | t->parents[i], budget, visit);
+    if(result != TINY_CONTINUE)
+      return result;
+  }
+  if(t->required & b)
+    return TINY_CONTINUE;
+  return tiny__search(t, semantics, i+1, in, attacked, conflict, budget, visit);
+}
+
+/**
+ * Calls visit(set) for all conflict-free sets, admissible sets, complete
+ * or stable extensions (semantics is one of SEM_*) of the given tiny AAF
+ * until it returns FALSE. Returns FALSE iff the given budget (of search
+ * nodes) is exhausted before.
+ */
+template<typename F> int tiny__enumerate(struct TinyAAF* t, int semantics, long* budget, F visit){
+  return tiny__search(t, semantics, 0, 0, 0, t->loops, budget, visit) != TINY_ABORT;
+}
+
+/**
+ * Adds the given set to the given sets, whose keys form an antichain,
+ * unless the key of some set is a strict superset of the given key; sets
+ * whose keys are strict subsets of it are dropped.
+ */
+void tiny__add_maximal(std::vector<uint64_t>& sets, std::vector<uint64_t>& keys, uint64_t set, uint64_t key){
+  size_t size = 0;
+  for(size_t k = 0; k < sets.size(); k++){
+    if((keys[k] & key) == key && keys[k] != key)
+      return;
+    if((keys[k] & key) == keys[k] && keys[k] != key)
+      continue;
+    sets[size] = sets[k];
+    keys[size++] = keys[k];
+  }
+  sets.resize(size);
+  keys.resize(size);
+  sets.push_back(set);
+  keys.push_back(key);
+}
+
+/** Prints the given set of arguments of the given AAF as a witness (cf. taas__print_witness()) */
+void tiny__print_witness(struct AAF* aaf, uint64_t set){
+  struct BitSet* witness = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(witness, aaf->number_of_arguments);
+  bitset__unsetAll(witness);
+  for(; set != 0; set &= set - 1)
+    bitset__set(witness, __builtin_ctzll(set));
+  taas__print_witness(aaf, witness);
+  bitset__destroy(witness);
+}
+
+/**
+ * Solves the task on the given AAF (with at most 64 arguments) by
+ * enumerating its extensions. Preferred, semi-stable and ideal extensions
+ * are derived from the complete extensions, stage extensions from the
+ * conflict-free sets (keeping those with maximal sets resp. ranges).
+ * Returns FALSE (without printing anything) if the AAF is too large, the
+ * task is not supported, or the budget is exhausted.
+ */
+int tiny__solve(struct TaskSpecification* task, struct AAF* aaf){
+  if(aaf->number_of_arguments > TAAS_TINY_MAX_ARGUMENTS || strcmp(task->track,"EA-PR") == 0)
+    return FALSE;
+  struct TinyAAF t;
+  tiny__from_aaf(&t, aaf);
+  const char* semantics = task->track+3;
+  int se = strncmp(task->track,"SE",2) == 0;
+  int dc = strncmp(task->track,"DC",2) == 0;
+  int ds = strncmp(task->track,"DS",2) == 0;
+  int ce = strncmp(task->track,"CE",2) == 0;
+  int id = strcmp(semantics,"ID") == 0;
+  int stg = strcmp(semantics,"STG") == 0;
+  // all sets are compared by their ranges except preferred (and ideal) ones
+  int by_range = stg || strcmp(semantics,"SST") == 0;
+  // credulous acceptance wrt. preferred semantics is decided via complete extensions
+  int maximal = (strcmp(semantics,"PR") == 0 && !dc) || id || by_range;
+  uint64_t query = dc || ds ? TINY_BIT(task->arg) : 0;
+  long budget = TAAS_TINY_BUDGET;
+  std::vector<uint64_t> extensions, keys;
+  long count = 0;
+  int finished;
+  if(!maximal){
+    finished = tiny__enumerate(&t, strcmp(semantics,"ST") == 0 ? SEM_ST : SEM_CO, &budget, [&](uint64_t set){
+      count++;
+      if(se || (dc && (set & query)) || (ds && !(set & query))){
+        extensions.push_back(set);
+        return FALSE;
+      }
+      return TRUE;
+    });
+  }else{
+    finished = tiny__enumerate(&t, stg ? SEM_CF : SEM_CO, &budget, [&](uint64_t set){
+      uint64_t key = by_range ? set | tiny__attacked(&t, set) : set;
+      if(se && !id){
+        // only one maximal set is needed: replacing the current set by any
+        // set with a strictly larger key ends with a maximal one
+        if(keys.empty() || ((key & keys[0]) == keys[0] && key != keys[0])){
+          extensions.assign(1, set);
+          keys.assign(1, key);
+        }
+      }else tiny__add_maximal(extensions, keys, set, key);
+      return TRUE;
+    });
+    count = extensions.size();
+  }
+  if(!finished)
+    return FALSE;
+  if(ce)
+    taas__print_count(aaf, count);
+  else if(id){
+    // the largest admissible subset of the intersection of all preferred extensions
+    uint64_t ideal = t.all;
+    for(size_t k = 0; k < extensions.size(); k++)
+      ideal &= extensions[k];
+    for(uint64_t previous = 0; previous != ideal; ){
+      previous = ideal;
+      ideal &= tiny__defended(&t, tiny__attacked(&t, ideal));
+    }
+    if(!se)
+      printf((ideal & query) ? "YES\n" : "NO\n");
+    if(se || PRINT_WITNESS)
+      tiny__print_witness(aaf, ideal);
+  }else if(se){
+    if(extensions.empty())
+      taas__print_no_extension(aaf);
+    else tiny__print_witness(aaf, extensions[0]);
+  }else{
+    int found = -1;
+    for(size_t k = 0; k < extensions.size() && found == -1; k++)
+      if((dc && (extensions[k] & query)) || (ds && !(extensions[k] & query)))
+        found = k;
+    printf((dc ? found != -1 : found == -1) ? "YES\n" : "NO\n");
+    if(PRINT_WITNESS && found != -1)
+      tiny__print_witness(aaf, extensions[found]);
+  }
+  return TRUE;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
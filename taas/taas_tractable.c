@@ -0,0 +1,318 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_tractable.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Classes of AAFs on which reasoning is tractable (AAFs with
+               a total grounded labelling, e.g. acyclic ones, symmetric
+               and bipartite AAFs) and dedicated algorithms for them.
+ ============================================================================
+ */
+
+/**
+ * Returns TRUE iff every attack of the given AAF is mutual and no argument
+ * attacks itself. As all rows of children and parents are sorted, the AAF
+ * is symmetric iff they coincide.
+ */
+int taas__aaf_is_symmetric(struct AAF* aaf){
+  int n = aaf->number_of_arguments;
+  if(bitset__next_set_bit(aaf->loops,0) != -1)
+    return FALSE;
+  if(memcmp(aaf->children_idx, aaf->parents_idx, (n+1) * sizeof(int)) != 0)
+    return FALSE;
+  return memcmp(aaf->children, aaf->parents, aaf->number_of_attacks * sizeof(int)) == 0;
+}
+
+/**
+ * Tries to colour the arguments of the given AAF with two colours
+ * (side[i] is 0 or 1) such that no argument attacks an argument of the
+ * same colour, where attacks between different components are ignored
+ * (if component is not NULL). Returns TRUE iff this is possible, i.e. iff
+ * the (undirected) AAF resp. each of its components is bipartite.
+ */
+int taas__aaf_two_colouring(struct AAF* aaf, int* component, int* side){
+  int n = aaf->number_of_arguments;
+  for(int i = 0; i < n; i++)
+    side[i] = -1;
+  int* queue = (int*) malloc((n+1) * sizeof(int));
+  int result = TRUE;
+  for(int root = 0; root < n && result; root++){
+    if(side[root] != -1)
+      continue;
+    int head = 0, tail = 0;
+    side[root] = 0;
+    queue[tail++] = root;
+    while(head < tail && result){
+      int v = queue[head++];
+      // visit both attackers and attacked arguments (a self-attack is a conflict)
+      for(int dir = 0; dir < 2 && result; dir++){
+        int* idx = dir == 0 ? aaf->children_idx : aaf->parents_idx;
+        int* adj = dir == 0 ? aaf->children : aaf->parents;
+        for(int k = idx[v]; k < idx[v+1]; k++){
+          int w = adj[k];
+          if(component != NULL && component[w] != component[v])
+            continue;
+          if(side[w] == -1){
+            side[w] = 1 - side[v];
+            queue[tail++] = w;
+          }else if(side[w] == side[v]){
+            result = FALSE;
+            break;
+          }
+        }
+      }
+    }
+  }
+  free(queue);
+  return result;
+}
+
+/**
+ * Returns TRUE iff the given AAF has no (directed) cycle of odd length,
+ * i.e. iff each of its strongly connected components is bipartite.
+ */
+int taas__aaf_is_odd_cycle_free(struct AAF* aaf){
+  taas__aaf_compute_sccs(aaf);
+  int* side = (int*) malloc((aaf->number_of_arguments+1) * sizeof(int));
+  int result = taas__aaf_two_colouring(aaf, aaf->scc, side);
+  free(side);
+  return result;
+}
+
+/**
+ * Sets extension (initialised with the number of arguments) to a maximal
+ * conflict-free set of the given symmetric AAF (cf.
+ * taas__aaf_is_symmetric()), chosen greedily starting with the given
+ * argument (if not -1). As every other argument is attacked by the set,
+ * this is a stable extension; in symmetric AAFs without self-attacks,
+ * stable and preferred extensions are exactly the maximal conflict-free
+ * sets (Coste-Marquis, Devred, Marquis. Symmetric argumentation
+ * frameworks. ECSQARU 2005).
+ */
+void taas__symmetric_extension(struct AAF* aaf, int arg, struct BitSet* extension){
+  int n = aaf->number_of_arguments;
+  struct BitSet* attacked = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(attacked, n);
+  bitset__unsetAll(attacked);
+  bitset__unsetAll(extension);
+  for(int i = -1; i < n; i++){
+    int a = i == -1 ? arg : i;
+    if(a == -1 || bitset__get(extension,a) || bitset__get(attacked,a))
+      continue;
+    bitset__set(extension,a);
+    for(int k = aaf->children_idx[a]; k < aaf->children_idx[a+1]; k++)
+      bitset__set(attacked,aaf->children[k]);
+  }
+  bitset__destroy(attacked);
+  // self-check (only if compiled without NDEBUG)
+  assert(taas__check_extension(aaf,extension,SEM_ST));
+}
+
+/**
+ * Sets set to the largest admissible subset of the arguments with colour s
+ * (cf. taas__aaf_two_colouring()) of the given bipartite AAF, disregarding
+ * the arguments in removed (if not NULL). Attackers of these arguments
+ * have the other colour and are only attacked by arguments with colour s,
+ * so arguments are dropped while some of their attackers is not attacked
+ * by the remaining ones. An argument is credulously accepted wrt.
+ * preferred semantics iff it is in the set for its colour (Dunne.
+ * Computational properties of argument systems satisfying graph-theoretic
+ * constraints. AIJ 2007).
+ */
+void taas__bipartite_admissible(struct AAF* aaf, int* side, int s, struct BitSet* removed, struct BitSet* set){
+  int n = aaf->number_of_arguments;
+  // the number of attackers in the set of each argument with the other colour
+  int* attackers = (int*) calloc(n+1, sizeof(int));
+  // the arguments with the other colour not attacked by the set
+  int* queue = (int*) malloc((n+1) * sizeof(int));
+  int head = 0, tail = 0;
+  bitset__unsetAll(set);
+  for(int i = 0; i < n; i++)
+    if(side[i] == s && (removed == NULL || !bitset__get(removed,i))){
+      bitset__set(set,i);
+      for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+        attackers[aaf->children[k]]++;
+    }
+  for(int i = 0; i < n; i++)
+    if(side[i] != s && (removed == NULL || !bitset__get(removed,i)) && attackers[i] == 0)
+      queue[tail++] = i;
+  while(head < tail){
+    int arg = queue[head++];
+    for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++){
+      int child = aaf->children[k];
+      if(!bitset__get(set,child))
+        continue;
+      bitset__unset(set,child);
+      for(int k2 = aaf->children_idx[child]; k2 < aaf->children_idx[child+1]; k2++){
+        int child2 = aaf->children[k2];
+        if((removed == NULL || !bitset__get(removed,child2)) && --attackers[child2] == 0)
+          queue[tail++] = child2;
+      }
+    }
+  }
+  free(attackers);
+  free(queue);
+}
+
+/** Adds the given set and all arguments attacked by it to removed */
+void taas__bipartite_remove(struct AAF* aaf, struct BitSet* set, struct BitSet* removed){
+  for(int a = bitset__next_set_bit(set,0); a != -1; a = bitset__next_set_bit(set,a+1)){
+    bitset__set(removed,a);
+    for(int k = aaf->children_idx[a]; k < aaf->children_idx[a+1]; k++)
+      bitset__set(removed,aaf->children[k]);
+  }
+}
+
+/**
+ * Extends the given admissible set of the given bipartite AAF to a
+ * preferred extension, which is also stable (bipartite AAFs have no odd
+ * cycles and are therefore coherent): the largest admissible subset of a
+ * colour of the reduct wrt. the set is added while one is non-empty. The
+ * set is preferred once the reduct has no non-empty admissible set
+ * (Baumann, Brewka, Ulbricht. Revisiting the foundations of abstract
+ * argumentation. KR 2020), and each admissible set of the reduct contains
+ * an admissible set of one colour.
+ */
+void taas__bipartite_preferred(struct AAF* aaf, int* side, struct BitSet* extension){
+  int n = aaf->number_of_arguments;
+  struct BitSet* removed = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(removed, n);
+  bitset__unsetAll(removed);
+  taas__bipartite_remove(aaf, extension, removed);
+  struct BitSet* set = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(set, n);
+  // stop once both colours failed in a row
+  int failed = 0;
+  for(int s = 0; failed < 2; s = 1 - s){
+    taas__bipartite_admissible(aaf, side, s, removed, set);
+    if(bitset__next_set_bit(set,0) == -1){
+      failed++;
+      continue;
+    }
+    failed = 0;
+    for(int a = bitset__next_set_bit(set,0); a != -1; a = bitset__next_set_bit(set,a+1))
+      bitset__set(extension,a);
+    taas__bipartite_remove(aaf, set, removed);
+  }
+  bitset__destroy(set);
+  bitset__destroy(removed);
+  // self-check (only if compiled without NDEBUG)
+  assert(taas__check_extension(aaf,extension,SEM_ST));
+}
+
+/**
+ * Prints the answer to the DC or DS query of the task and, if it is to be
+ * witnessed (YES for DC, NO for DS), the given extension.
+ */
+void taas__print_answer(struct TaskSpecification* task, struct AAF* aaf, int accepted, struct BitSet* extension){
+  printf(accepted ? "YES\n" : "NO\n");
+  if(PRINT_WITNESS && accepted == (strncmp(task->track,"DC",2) == 0))
+    taas__print_witness(aaf,extension);
+}
+
+/**
+ * Solves the task on the given AAF without any SAT solver if the AAF is in
+ * a class on which this is possible in (near-)linear time, and returns
+ * TRUE iff it did so:
+ * - if the grounded labelling is total (e.g. if the AAF is acyclic), the
+ *   grounded extension is the only extension wrt. all semantics,
+ * - in symmetric AAFs without self-attacks (cf. taas__symmetric_extension())
+ *   every argument is credulously accepted and exactly the unattacked ones
+ *   are skeptically accepted,
+ * - in bipartite AAFs (cf. taas__bipartite_admissible() and
+ *   taas__bipartite_preferred()) an argument is skeptically accepted iff
+ *   none of its attackers is credulously accepted.
+ * In the latter two classes, preferred, stable, semi-stable and stage
+ * extensions coincide (DC-CO is DC-PR). Other AAFs without odd cycles are
+ * coherent as well, so tasks are reduced to the corresponding (easier)
+ * ones for stable semantics there, but these are not solved here. This
+ * needs the strongly connected components, so it is only checked if
+ * check_odd_cycles is TRUE.
+ */
+int taas__solve_tractable(struct TaskSpecification* task, struct AAF* aaf, struct Labeling* grounded, int check_odd_cycles){
+  int n = aaf->number_of_arguments;
+  const char* semantics = task->track+3;
+  int se = strncmp(task->track,"SE",2) == 0;
+  int dc = strncmp(task->track,"DC",2) == 0;
+  int ds = strncmp(task->track,"DS",2) == 0;
+  int ce = strncmp(task->track,"CE",2) == 0;
+  int coherent = strcmp(semantics,"PR") == 0 || strcmp(semantics,"ST") == 0 ||
+      strcmp(semantics,"SST") == 0 || strcmp(semantics,"STG") == 0;
+  // (the ideal extension is solved and printed differently)
+  if(!(coherent || strcmp(semantics,"CO") == 0) || !(se || dc || ds || ce))
+    return FALSE;
+  if(bitset__count(grounded->in) + bitset__count(grounded->out) == n){
+    if(se)
+      taas__print_witness(aaf,grounded->in);
+    else if(ce)
+      taas__print_count(aaf,1);
+    else taas__print_answer(task,aaf,bitset__get(grounded->in,task->arg),grounded->in);
+    return TRUE;
+  }
+  if(ce || (!coherent && !dc)){
+    if(check_odd_cycles && strcmp(task->track,"CE-PR") == 0 && taas__aaf_is_odd_cycle_free(aaf))
+      task->track = (char*) "CE-ST";
+    return FALSE;
+  }
+  struct BitSet* extension = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(extension, n);
+  bitset__unsetAll(extension);
+  int solved = TRUE;
+  int* side = (int*) malloc((n+1) * sizeof(int));
+  if(taas__aaf_is_symmetric(aaf)){
+    if(se){
+      taas__symmetric_extension(aaf,-1,extension);
+      taas__print_witness(aaf,extension);
+    }else if(dc){
+      taas__symmetric_extension(aaf,task->arg,extension);
+      taas__print_answer(task,aaf,TRUE,extension);
+    }else{
+      int unattacked = aaf->parents_idx[task->arg] == aaf->parents_idx[task->arg+1];
+      if(!unattacked)
+        taas__symmetric_extension(aaf,aaf->parents[aaf->parents_idx[task->arg]],extension);
+      taas__print_answer(task,aaf,unattacked,extension);
+    }
+  }else if(taas__aaf_two_colouring(aaf,NULL,side)){
+    if(se){
+      taas__bipartite_preferred(aaf,side,extension);
+      taas__print_witness(aaf,extension);
+    }else if(dc){
+      taas__bipartite_admissible(aaf,side,side[task->arg],NULL,extension);
+      int accepted = bitset__get(extension,task->arg);
+      if(accepted && PRINT_WITNESS)
+        taas__bipartite_preferred(aaf,side,extension);
+      taas__print_answer(task,aaf,accepted,extension);
+    }else{
+      taas__bipartite_admissible(aaf,side,1-side[task->arg],NULL,extension);
+      int accepted = TRUE;
+      for(int k = aaf->parents_idx[task->arg]; k < aaf->parents_idx[task->arg+1]; k++)
+        if(bitset__get(extension,aaf->parents[k]))
+          accepted = FALSE;
+      if(!accepted && PRINT_WITNESS)
+        taas__bipartite_preferred(aaf,side,extension);
+      taas__print_answer(task,aaf,accepted,extension);
+    }
+  }else{
+    solved = FALSE;
+    if(check_odd_cycles && coherent && strcmp(semantics,"ST") != 0 && !(dc && strcmp(semantics,"PR") == 0) &&
+        taas__aaf_is_odd_cycle_free(aaf)){
+      // DC-PR is kept, as it is solved on the cone of the argument
+      if(se)
+        task->track = (char*) "SE-ST";
+      else if(dc)
+        task->track = (char*) "DC-ST";
+      else task->track = (char*) "DS-ST";
+    }
+  }
+  free(side);
+  bitset__destroy(extension);
+  return solved;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
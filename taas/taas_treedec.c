@@ -0,0 +1,326 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_treedec.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Tree decompositions of AAFs (from a min-degree elimination
+               order) and a dynamic programming algorithm on them that
+               counts complete and stable labellings in time linear in
+               the size of the AAF and exponential only in the width of
+               the decomposition (e.g. for chains or grid-like AAFs).
+ ============================================================================
+ */
+
+/** The maximal width of decompositions (larger ones are given up) */
+#define TAAS_TREEDEC_MAX_WIDTH 12
+/** The maximal number of table entries of the dynamic programming */
+#define TAAS_TREEDEC_MAX_ENTRIES (1 << 24)
+/**
+ * Counting by dynamic programming is only tried once the SAT solver has
+ * found more extensions (few extensions are counted faster by it)
+ */
+#define TAAS_TREEDEC_MIN_COUNT 64
+
+/**
+ * The labels of an argument in the tables of the dynamic programming; an
+ * argument labelled out or undec may or may not be justified (attacked by
+ * an argument labelled in resp. undec). Tables count the labellings in
+ * which arguments labelled *_NONE are not justified by the attacks
+ * considered so far, and all labellings for arguments labelled *_ANY.
+ * Then the tables of different subtrees are joined by multiplying
+ * entries, and the labellings where an argument is justified are counted
+ * by the difference of both. Stable labellings only use the first three.
+ */
+#define TREEDEC_IN 0
+#define TREEDEC_OUT_NONE 1
+#define TREEDEC_OUT_ANY 2
+#define TREEDEC_UNDEC_NONE 3
+#define TREEDEC_UNDEC_ANY 4
+
+/**
+ * A tree decomposition of an AAF given by an elimination order of its
+ * arguments: the bag of argument a consists of a and the arguments
+ * bag[bag_idx[a]],...,bag[bag_idx[a+1]-1], its neighbours eliminated
+ * after it; the parent of the bag of a is the bag of the first of these
+ * arguments eliminated (-1 if there is none).
+ */
+struct TreeDecomposition{
+  int width;
+  /** order[k] is the k-th argument eliminated */
+  int* order;
+  int* parent;
+  int* bag_idx;
+  int* bag;
+};
+
+void treedec__destroy(struct TreeDecomposition* td){
+  free(td->order);
+  free(td->parent);
+  free(td->bag_idx);
+  free(td->bag);
+  free(td);
+}
+
+/**
+ * Returns a tree decomposition of the (undirected) graph of the given AAF
+ * where in each step an argument of minimal degree is eliminated and its
+ * remaining neighbours are made pairwise adjacent; returns NULL if its
+ * width would exceed the given maximal width.
+ */
+struct TreeDecomposition* treedec__decompose(struct AAF* aaf, int max_width){
+  int n = aaf->number_of_arguments;
+  // neighbourhoods (eliminated arguments are removed lazily)
+  std::vector<std::vector<int> > neighbours(n);
+  for(int a = 0; a < n; a++)
+    for(int k = aaf->children_idx[a]; k < aaf->children_idx[a+1]; k++){
+      int b = aaf->children[k];
+      // mutual attacks are added once
+      if(a == b || (b < a && std::binary_search(aaf->parents + aaf->parents_idx[a], aaf->parents + aaf->parents_idx[a+1], b)))
+        continue;
+      neighbours[a].push_back(b);
+      neighbours[b].push_back(a);
+    }
+  int* degree = (int*) malloc((n+1) * sizeof(int));
+  char* eliminated = (char*) calloc(n+1, 1);
+  // for checking adjacency, the neighbours of an argument x are marked by
+  // setting their stamps to x
+  int* stamp = (int*) malloc((n+1) * sizeof(int));
+  // arguments by degree (only up to max_width, entries with outdated
+  // degrees are skipped)
+  std::vector<std::vector<int> > buckets(max_width+1);
+  for(int a = 0; a < n; a++){
+    degree[a] = neighbours[a].size();
+    stamp[a] = -1;
+    if(degree[a] <= max_width)
+      buckets[degree[a]].push_back(a);
+  }
+  int* order = (int*) malloc((n+1) * sizeof(int));
+  int* position = (int*) malloc((n+1) * sizeof(int));
+  // the bags in order of elimination
+  std::vector<int> bags, bags_idx;
+  int width = 0, k = 0;
+  for(int d = 0; d <= max_width; ){
+    if(buckets[d].empty()){
+      d++;
+      continue;
+    }
+    int a = buckets[d].back();
+    buckets[d].pop_back();
+    if(eliminated[a] || d != degree[a])
+      continue;
+    eliminated[a] = TRUE;
+    position[a] = k;
+    order[k++] = a;
+    bags_idx.push_back(bags.size());
+    for(size_t i = 0; i < neighbours[a].size(); i++)
+      if(!eliminated[neighbours[a][i]])
+        bags.push_back(neighbours[a][i]);
+    std::vector<int>().swap(neighbours[a]);
+    width = std::max(width, d);
+    // the remaining neighbours become a clique (eliminated arguments are
+    // removed from their neighbourhoods on the way)
+    int start = bags_idx.back();
+    for(int i = start; i < (int) bags.size(); i++){
+      int x = bags[i];
+      std::vector<int>& nx = neighbours[x];
+      size_t size = 0;
+      for(size_t j = 0; j < nx.size(); j++)
+        if(!eliminated[nx[j]]){
+          stamp[nx[j]] = x;
+          nx[size++] = nx[j];
+        }
+      nx.resize(size);
+      for(int j = start; j < i; j++){
+        int y = bags[j];
+        if(stamp[y] == x)
+          continue;
+        nx.push_back(y);
+        neighbours[y].push_back(x);
+      }
+    }
+    for(int i = start; i < (int) bags.size(); i++){
+      int x = bags[i];
+      degree[x] = neighbours[x].size();
+      if(degree[x] <= max_width){
+        buckets[degree[x]].push_back(x);
+        d = std::min(d, degree[x]);
+      }
+    }
+  }
+  bags_idx.push_back(bags.size());
+  free(degree);
+  free(eliminated);
+  free(stamp);
+  if(k < n){
+    free(order);
+    free(position);
+    return NULL;
+  }
+  struct TreeDecomposition* td = (struct TreeDecomposition*) malloc(sizeof(struct TreeDecomposition));
+  td->width = width;
+  td->order = order;
+  td->parent = (int*) malloc((n+1) * sizeof(int));
+  td->bag_idx = (int*) malloc((n+1) * sizeof(int));
+  td->bag = (int*) malloc((bags.size()+1) * sizeof(int));
+  int idx = 0;
+  for(int a = 0; a < n; a++){
+    td->bag_idx[a] = idx;
+    td->parent[a] = -1;
+    for(int i = bags_idx[position[a]]; i < bags_idx[position[a]+1]; i++){
+      td->bag[idx++] = bags[i];
+      if(td->parent[a] == -1 || position[bags[i]] < position[td->parent[a]])
+        td->parent[a] = bags[i];
+    }
+  }
+  td->bag_idx[n] = idx;
+  free(position);
+  return td;
+}
+
+/** Returns the number of entries of the table of the bag of the given argument (cf. treedec__count()) */
+long treedec__table_size(struct TreeDecomposition* td, int arg, int labels){
+  long size = 1;
+  for(int k = td->bag_idx[arg]; k < td->bag_idx[arg+1]; k++)
+    size *= labels;
+  return size;
+}
+
+/**
+ * Counts the complete (semantics is SEM_CO) or stable (SEM_ST) labellings
+ * of the given AAF that agree with the given grounded labelling by dynamic
+ * programming on a tree decomposition and prints their number (cf.
+ * taas__print_count_bignum()). Returns FALSE (without printing anything)
+ * if the AAF has no narrow decomposition.
+ *
+ * The table of an argument a is computed when a is eliminated: for each
+ * labelling of the bag of a (without a), it counts the labellings of the
+ * arguments eliminated in the subtree of a that agree with it on all
+ * attacks incident to these arguments. It is the product of the tables of
+ * the children of a, restricted to the attacks between a and its bag and
+ * summed over the labels of a (where a has to be justified).
+ */
+int treedec__count(struct AAF* aaf, struct Labeling* grounded, int semantics){
+  int n = aaf->number_of_arguments;
+  struct TreeDecomposition* td = treedec__decompose(aaf, TAAS_TREEDEC_MAX_WIDTH);
+  if(td == NULL)
+    return FALSE;
+  int labels = semantics == SEM_ST ? 3 : 5;
+  long entries = 0;
+  for(int a = 0; a < n && entries <= TAAS_TREEDEC_MAX_ENTRIES; a++)
+    entries += treedec__table_size(td, a, labels) * labels;
+  if(entries > TAAS_TREEDEC_MAX_ENTRIES){
+    treedec__destroy(td);
+    return FALSE;
+  }
+  // the labels of an argument in the order they are summed up (all
+  // labellings where it is justified are added before those where it is
+  // not are subtracted, so that sums never become negative)
+  static const int sequence[5] = {TREEDEC_IN, TREEDEC_OUT_ANY, TREEDEC_UNDEC_ANY, TREEDEC_OUT_NONE, TREEDEC_UNDEC_NONE};
+  static const int sequence_st[3] = {TREEDEC_IN, TREEDEC_OUT_ANY, TREEDEC_OUT_NONE};
+  const int* labels_of = semantics == SEM_ST ? sequence_st : sequence;
+  // the tables of the arguments whose parents are not eliminated yet
+  std::vector<struct BigNum*> tables(n, (struct BigNum*) NULL);
+  std::vector<std::vector<int> > children(n);
+  struct BigNum* count = (struct BigNum*) malloc(sizeof(struct BigNum));
+  bignum__init(count, 1);
+  struct BigNum product;
+  bignum__init(&product, 1);
+  for(int i = 0; i < n; i++){
+    int a = td->order[i];
+    int* bag = td->bag + td->bag_idx[a];
+    int d = td->bag_idx[a+1] - td->bag_idx[a];
+    // the labels of a (position 0) and of its bag (positions 1,...,d);
+    // the labels of the bag are the digits (wrt. base labels) of the index
+    // of an entry of the table of a
+    std::vector<int> label(d+1);
+    // the positions of the arguments of the bags of the children
+    std::vector<std::vector<int> > positions(children[a].size());
+    for(size_t c = 0; c < children[a].size(); c++){
+      int child = children[a][c];
+      for(int k = td->bag_idx[child]; k < td->bag_idx[child+1]; k++){
+        int p = 0;
+        while(p < d && td->bag[k] != a && bag[p] != td->bag[k])
+          p++;
+        positions[c].push_back(td->bag[k] == a ? 0 : p+1);
+      }
+    }
+    // the attacks between a and its bag (as pairs of positions)
+    std::vector<std::pair<int,int> > attacks;
+    if(bitset__get(aaf->loops,a))
+      attacks.push_back(std::make_pair(0, 0));
+    for(int p = 1; p <= d; p++){
+      int b = bag[p-1];
+      if(std::binary_search(aaf->children + aaf->children_idx[a], aaf->children + aaf->children_idx[a+1], b))
+        attacks.push_back(std::make_pair(0, p));
+      if(std::binary_search(aaf->parents + aaf->parents_idx[a], aaf->parents + aaf->parents_idx[a+1], b))
+        attacks.push_back(std::make_pair(p, 0));
+    }
+    long size = treedec__table_size(td, a, labels);
+    struct BigNum* table = (struct BigNum*) malloc(size * sizeof(struct BigNum));
+    for(long e = 0; e < size; e++){
+      struct BigNum* sum = table + e;
+      bignum__init(sum, 0);
+      for(int p = 1, rest = e; p <= d; p++, rest /= labels)
+        label[p] = rest % labels;
+      for(int o = 0; o < labels; o++){
+        int l = label[0] = labels_of[o];
+        if(bitset__get(grounded->in,a) && l != TREEDEC_IN)
+          continue;
+        if(bitset__get(grounded->out,a) && l != TREEDEC_OUT_NONE && l != TREEDEC_OUT_ANY)
+          continue;
+        int consistent = TRUE;
+        for(size_t k = 0; k < attacks.size() && consistent; k++){
+          int from = label[attacks[k].first];
+          int to = label[attacks[k].second];
+          // arguments attacked by in are out (and justified), attackers of
+          // in are out, and undec ones attacked by undec are justified
+          if((from == TREEDEC_IN && to != TREEDEC_OUT_ANY) ||
+              (to == TREEDEC_IN && from != TREEDEC_OUT_NONE && from != TREEDEC_OUT_ANY) ||
+              (to == TREEDEC_UNDEC_NONE && (from == TREEDEC_UNDEC_NONE || from == TREEDEC_UNDEC_ANY)))
+            consistent = FALSE;
+        }
+        if(!consistent)
+          continue;
+        bignum__set_ulong(&product, 1);
+        for(size_t c = 0; c < children[a].size() && !bignum__is_zero(&product); c++){
+          long index = 0;
+          for(int j = positions[c].size()-1; j >= 0; j--)
+            index = index * labels + label[positions[c][j]];
+          bignum__mul(&product, tables[children[a][c]] + index);
+        }
+        if(l == TREEDEC_OUT_NONE || l == TREEDEC_UNDEC_NONE)
+          bignum__sub(sum, &product);
+        else bignum__add(sum, &product);
+      }
+    }
+    for(size_t c = 0; c < children[a].size(); c++){
+      int child = children[a][c];
+      long child_size = treedec__table_size(td, child, labels);
+      for(long e = 0; e < child_size; e++)
+        free(tables[child][e].digits);
+      free(tables[child]);
+      tables[child] = NULL;
+    }
+    if(td->parent[a] == -1){
+      // a is the root of a tree of the decomposition
+      bignum__mul(count, table);
+      free(table[0].digits);
+      free(table);
+    }else{
+      tables[a] = table;
+      children[td->parent[a]].push_back(a);
+    }
+  }
+  free(product.digits);
+  treedec__destroy(td);
+  taas__print_count_bignum(aaf, count);
+  return TRUE;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
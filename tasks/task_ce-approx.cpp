@@ -0,0 +1,343 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : task_ce-approx.cpp
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : approximate counting for CE-CO, CE-ST and CE-PR by hashing
+               (in the style of ApproxMC): random XOR constraints over the
+               in-variables split the extensions into cells, and the size of
+               a small cell times the number of cells estimates the count
+ ============================================================================
+ */
+
+/** Default tolerance (the estimate is within a factor 1+epsilon of the count) */
+#define TAAS_APPROX_EPSILON 0.8
+/** Default confidence (the estimate is within the tolerance with probability 1-delta) */
+#define TAAS_APPROX_DELTA 0.2
+/** Bound of the probability that the estimate of one iteration is not within the tolerance */
+#define TAAS_APPROX_ITERATION_ERROR 0.36
+/** Seed of the random hash functions (so that estimates are reproducible) */
+#define TAAS_APPROX_SEED 4242
+
+/**
+ * State of the approximate counter: the encoding of the semantics in an
+ * incremental SAT solver and the XOR constraints of the current hash.
+ */
+struct ApproxCounter{
+  struct AAF* aaf;
+  /** One of "CO", "ST" and "PR" */
+  const char* semantics;
+  IpasirSolver solver;
+  int* in_vars;
+  int* out_vars;
+  /** The highest variable in use */
+  int number_of_variables;
+  /** The in-variables of the arguments not decided by the grounded extension */
+  std::vector<int> support;
+  /** The activation literals of the XOR constraints of the current hash */
+  std::vector<int> rows;
+  /**
+   * The XOR constraints of the current hash in echelon form (as bit vectors
+   * over the support, the parity being the last bit) and their pivots
+   */
+  std::vector<std::vector<uint64_t> > matrix;
+  std::vector<int> pivots;
+  /** The bound of cell sizes: cells are counted up to it */
+  long threshold;
+  std::mt19937_64 random;
+  /** buffer for clauses */
+  std::vector<int> clause;
+};
+
+/** Returns TRUE iff the task asks for an approximate count (i.e., -epsilon or -delta is given) */
+int approx__requested(struct TaskSpecification *task){
+  return taas__task_get_value(task,(char*)"-epsilon") != NULL || taas__task_get_value(task,(char*)"-delta") != NULL;
+}
+
+/**
+ * Returns the smallest odd number of iterations such that their median is
+ * not within the tolerance with probability at most delta, i.e., such that
+ * at least half of them fail with probability at most delta (by the tail
+ * of the binomial distribution, which needs far fewer iterations than the
+ * Chernoff bound 17*log2(3/delta)).
+ */
+int approx__iterations(double delta){
+  double p = TAAS_APPROX_ITERATION_ERROR;
+  for(int t = 1; ; t += 2){
+    double tail = 0;
+    for(int k = (t+1)/2; k <= t; k++)
+      tail += exp(lgamma(t+1) - lgamma(k+1) - lgamma(t-k+1) + k*log(p) + (t-k)*log(1-p));
+    if(tail <= delta)
+      return t;
+  }
+}
+
+/** Returns a fresh variable */
+int approx__fresh(struct ApproxCounter* c){
+  return ++c->number_of_variables;
+}
+
+/**
+ * Starts a new hash: the solver is re-initialised with the encoding of the
+ * semantics (admissibility for preferred semantics) and no XOR constraints.
+ */
+void approx__reset(struct ApproxCounter* c, struct Labeling* grounded){
+  if(c->solver.theSolver != NULL)
+    sat__free(c->solver);
+  int n = c->aaf->number_of_arguments;
+  sat__init(c->solver, 2*n+1);
+  if(strcmp(c->semantics,"ST") == 0)
+    add_stbTestClauses(c->solver,c->in_vars,c->aaf,grounded);
+  else if(strcmp(c->semantics,"CO") == 0)
+    add_comTestClauses(c->solver,c->in_vars,c->out_vars,c->aaf,grounded);
+  else add_admTestClauses(c->solver,c->in_vars,c->out_vars,c->aaf,grounded);
+  c->number_of_variables = 2*n;
+  c->rows.clear();
+  c->matrix.clear();
+  c->pivots.clear();
+}
+
+/**
+ * Adds the next XOR constraint of the current hash: each support variable
+ * occurs with probability 1/2, and the parity is random. The pivots of the
+ * previous constraints are eliminated from it (which does not change the
+ * cells), so that once all other variables are assigned, the pivots follow
+ * by unit propagation. The XOR is encoded as a chain of fresh variables
+ * (each the XOR of its predecessor and one variable of the constraint) and
+ * is only enforced if its activation literal is assumed, so that the cells
+ * of the first m constraints can be queried for any m.
+ */
+void approx__add_row(struct ApproxCounter* c){
+  int k = c->support.size();
+  int words = k/64 + 1;
+  std::vector<uint64_t> bits(words);
+  for(int w = 0; w < words; w++)
+    bits[w] = c->random();
+  // the bits beyond the support are cleared, except the parity
+  bits[k/64] &= ((uint64_t) 1 << (k%64)) | (((uint64_t) 1 << (k%64)) - 1);
+  for(size_t r = 0; r < c->matrix.size(); r++)
+    if(c->pivots[r] >= 0 && (bits[c->pivots[r]/64] >> (c->pivots[r]%64)) & 1)
+      for(int w = 0; w < words; w++)
+        bits[w] ^= c->matrix[r][w];
+  int pivot = -1;
+  for(int i = 0; i < k && pivot < 0; i++)
+    if((bits[i/64] >> (i%64)) & 1)
+      pivot = i;
+  c->matrix.push_back(bits);
+  c->pivots.push_back(pivot);
+  int row = approx__fresh(c);
+  c->rows.push_back(row);
+  int acc = 0;
+  for(int i = k-1; i >= 0; i--){
+    if(!((bits[i/64] >> (i%64)) & 1))
+      continue;
+    int var = c->support[i];
+    if(acc == 0){
+      acc = var;
+      continue;
+    }
+    // y <-> (acc xor var)
+    int y = approx__fresh(c);
+    sat__addClause3(c->solver,-y,acc,var);
+    sat__addClause3(c->solver,-y,-acc,-var);
+    sat__addClause3(c->solver,y,-acc,var);
+    sat__addClause3(c->solver,y,acc,-var);
+    acc = y;
+  }
+  int parity = (bits[k/64] >> (k%64)) & 1;
+  if(acc == 0){
+    // the empty XOR is violated iff its parity is odd
+    if(parity)
+      sat__addClause1(c->solver,-row);
+  }else sat__addClause2(c->solver,-row,parity ? acc : -acc);
+}
+
+/** Assumes the first m XOR constraints of the current hash and the given literal */
+void approx__assume(struct ApproxCounter* c, int m, int lit){
+  for(int r = 0; r < m; r++)
+    sat__assume(c->solver,c->rows[r]);
+  sat__assume(c->solver,lit);
+}
+
+/**
+ * Extends the given admissible set by a model with some further argument
+ * in, under the first m XOR constraints and the given literal (cf.
+ * extend_admSet()); returns TRUE iff there is one.
+ */
+int approx__extend(struct ApproxCounter* c, std::vector<char>& set, int m, int lit){
+  std::vector<int> assumptions(c->rows.begin(), c->rows.begin() + m);
+  assumptions.push_back(lit);
+  return extend_admSet(c->solver, c->in_vars, c->aaf, set, assumptions, approx__fresh(c));
+}
+
+/** Returns TRUE iff the given set satisfies the first m XOR constraints of the current hash */
+int approx__in_cell(struct ApproxCounter* c, std::vector<char>& set, int m){
+  int k = c->support.size();
+  for(int r = 0; r < m; r++){
+    int parity = (c->matrix[r][k/64] >> (k%64)) & 1;
+    for(int i = 0; i < k; i++)
+      if(set[(c->support[i]-1)/2] && ((c->matrix[r][i/64] >> (i%64)) & 1))
+        parity ^= 1;
+    if(parity)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/**
+ * Returns the number of extensions in the cell of the first m XOR
+ * constraints of the current hash, or the threshold if there are more.
+ * For complete and stable semantics, the models in the cell are
+ * enumerated. For preferred semantics, an admissible set in the cell is
+ * extended to a maximal one in the cell and then to a preferred extension,
+ * which is counted if it is in the cell; no other preferred extension is a
+ * subset of it, so all its subsets are excluded from the cell. Clauses
+ * excluding models are conditioned on an activation literal that is
+ * retired afterwards.
+ */
+long approx__cell(struct ApproxCounter* c, int m){
+  while((int) c->rows.size() < m)
+    approx__add_row(c);
+  int n = c->aaf->number_of_arguments;
+  int pr = strcmp(c->semantics,"PR") == 0;
+  int cell = approx__fresh(c);
+  std::vector<char> set(n);
+  long count = 0;
+  while(count < c->threshold){
+    approx__assume(c,m,cell);
+    if(sat__solve(c->solver) != 10)
+      break;
+    if(pr){
+      for(int i = 0; i < n; i++)
+        set[i] = sat__get(c->solver,c->in_vars[i]) > 0;
+      // maximise within the cell
+      while(approx__extend(c,set,m,cell))
+        continue;
+      if(!approx__extend(c,set,0,cell))
+        count++;
+      else{
+        // maximise globally (the resulting preferred extension may still be in the cell)
+        while(approx__extend(c,set,0,cell))
+          continue;
+        if(approx__in_cell(c,set,m))
+          count++;
+      }
+      c->clause.clear();
+      c->clause.push_back(-cell);
+      for(int i = 0; i < n; i++)
+        if(!set[i])
+          c->clause.push_back(c->in_vars[i]);
+    }else{
+      count++;
+      c->clause.clear();
+      c->clause.push_back(-cell);
+      for(int var: c->support)
+        c->clause.push_back(sat__get(c->solver,var) > 0 ? -var : var);
+    }
+    sat__addClause(c->solver,c->clause.data(),c->clause.size());
+  }
+  sat__addClause1(c->solver,-cell);
+  return count;
+}
+
+/**
+ * Estimates the number of complete, stable or preferred extensions (as
+ * given by the track of the task) and prints it. With tolerance epsilon
+ * and confidence delta (the values of -epsilon and -delta), the estimate
+ * is within [count/(1+epsilon), count*(1+epsilon)] with probability at
+ * least 1-delta; if an AAF is split into components, this holds for each
+ * component whose count is estimated. Counts below the threshold of cell
+ * sizes are exact, and so are counts by dynamic programming (cf.
+ * treedec__count()) if the treewidth is small.
+ *
+ * Each of the iterations draws a new hash and searches for the smallest
+ * number m of XOR constraints such that the cell has less than threshold
+ * extensions (starting at the m of the previous iteration, as neighbouring
+ * iterations tend to agree); the estimate of the iteration is the size of
+ * the cell times 2^m, and the median of the estimates is printed.
+ */
+void approx__count(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded){
+  char* value = taas__task_get_value(task,(char*)"-epsilon");
+  double epsilon = value != NULL ? atof(value) : TAAS_APPROX_EPSILON;
+  value = taas__task_get_value(task,(char*)"-delta");
+  double delta = value != NULL ? atof(value) : TAAS_APPROX_DELTA;
+  if(!(epsilon > 0))
+    epsilon = TAAS_APPROX_EPSILON;
+  if(!(delta > 0 && delta < 1))
+    delta = TAAS_APPROX_DELTA;
+  struct ApproxCounter c;
+  c.aaf = aaf;
+  c.semantics = task->track + 3;
+  c.threshold = (long) ceil(1 + 9.84 * (1 + epsilon/(1+epsilon)) * (1 + 1/epsilon) * (1 + 1/epsilon));
+  c.random.seed(TAAS_APPROX_SEED);
+  int n = aaf->number_of_arguments;
+  c.in_vars = (int*) malloc(n * sizeof(int));
+  c.out_vars = (int*) malloc(n * sizeof(int));
+  for(int i = 0; i < n; i++){
+    c.in_vars[i] = 2*i+1;
+    c.out_vars[i] = 2*i+2;
+    if(!bitset__get(grounded->in,i) && !bitset__get(grounded->out,i))
+      c.support.push_back(c.in_vars[i]);
+  }
+  approx__reset(&c, grounded);
+  // small numbers are counted exactly
+  long count = approx__cell(&c, 0);
+  if(count < c.threshold){
+    taas__print_count(aaf,count);
+  }else if(strcmp(c.semantics,"PR") == 0 || !treedec__count(aaf, grounded, strcmp(c.semantics,"ST") == 0 ? SEM_ST : SEM_CO)){
+    int iterations = approx__iterations(delta);
+    int number_of_rows = c.support.size();
+    // estimates as (cell size, m), ordered by their logarithm
+    std::vector<std::pair<double,std::pair<long,int>>> estimates;
+    int previous = 1;
+    for(int it = 0; it < iterations; it++){
+      if(it > 0)
+        approx__reset(&c, grounded);
+      // the cell of lo constraints is too large, the one of hi is not
+      // (for hi = number_of_rows, this is not checked)
+      std::vector<long> counts(number_of_rows+1, -1);
+      counts[0] = c.threshold;
+      int lo = 0, hi = number_of_rows;
+      int m = previous, step = 1, direction = 0;
+      while(hi - lo > 1){
+        m = std::max(lo+1, std::min(m, hi-1));
+        counts[m] = approx__cell(&c, m);
+        int up = counts[m] >= c.threshold ? 1 : -1;
+        if(up > 0)
+          lo = m;
+        else hi = m;
+        // gallop away from the previous m until the search is bracketed, then bisect
+        if(direction == 0 || direction == up){
+          direction = up;
+          m += up * step;
+          step *= 2;
+        }else{
+          direction = 2;
+          m = (lo + hi) / 2;
+        }
+      }
+      if(counts[hi] < 0)
+        counts[hi] = approx__cell(&c, hi);
+      previous = hi;
+      estimates.push_back(std::make_pair(counts[hi] > 0 ? log2((double) counts[hi]) + hi : -1.0, std::make_pair(counts[hi], hi)));
+    }
+    std::sort(estimates.begin(), estimates.end());
+    std::pair<long,int> median = estimates[estimates.size()/2].second;
+    struct BigNum* estimate = (struct BigNum*) malloc(sizeof(struct BigNum));
+    bignum__init(estimate, median.first);
+    for(int r = median.second; r > 0; r -= 30)
+      bignum__mul_ulong(estimate, 1UL << std::min(r,30));
+    taas__print_count_bignum(aaf, estimate);
+  }
+  sat__free(c.solver);
+  free(c.in_vars);
+  free(c.out_vars);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
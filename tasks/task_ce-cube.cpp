@@ -0,0 +1,175 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : task_ce-cube.cpp
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : parallel counting for CE-CO, CE-ST and CE-PR by cube and
+               conquer: the extensions are split by the labels of a few
+               undecided arguments of high out-degree into disjoint cubes,
+               which are counted by several threads with one SAT solver each
+ ============================================================================
+ */
+
+/** The number of cubes per thread (more cubes balance the load better) */
+#define TAAS_CUBES_PER_THREAD 4
+/** The number of preferred extensions found by a single thread before
+ *  the counting is split into cubes */
+#define TAAS_CUBE_MIN_COUNT 64
+
+/**
+ * Counts the extensions (of the semantics of the task, one of "CO", "ST"
+ * and "PR") that contain exactly those of the given split arguments that
+ * are in the given cube (a bit mask over them), with a new SAT solver.
+ * The split arguments are fixed by unit clauses for complete and stable
+ * semantics, whose models are enumerated projected onto the other
+ * undecided arguments (cf. sat__enumerate()). For preferred semantics,
+ * an admissible set in the cube is extended to a maximal one in the cube
+ * and then to a preferred extension, which is counted if it is in the
+ * cube; no other preferred extension is a subset of it, so all its
+ * subsets are excluded by a clause of this solver.
+ */
+long cube__count_cube(struct AAF* aaf, struct Labeling* grounded, const char* semantics, std::vector<int>& split, long cube){
+  int n = aaf->number_of_arguments;
+  IpasirSolver solver;
+  sat__init(solver, 2*n+1);
+  int* in_vars = (int*) malloc(n * sizeof(int));
+  int* out_vars = (int*) malloc(n * sizeof(int));
+  for(int i = 0; i < n; i++){
+    in_vars[i] = 2*i+1;
+    out_vars[i] = 2*i+2;
+  }
+  if(strcmp(semantics,"ST") == 0)
+    add_stbTestClauses(solver,in_vars,aaf,grounded);
+  else if(strcmp(semantics,"CO") == 0)
+    add_comTestClauses(solver,in_vars,out_vars,aaf,grounded);
+  else add_admTestClauses(solver,in_vars,out_vars,aaf,grounded);
+  std::vector<int> cube_lits;
+  std::vector<char> in_split(n);
+  for(size_t j = 0; j < split.size(); j++){
+    cube_lits.push_back((cube >> j) & 1 ? in_vars[split[j]] : -in_vars[split[j]]);
+    in_split[split[j]] = TRUE;
+  }
+  long count = 0;
+  if(strcmp(semantics,"PR") != 0){
+    for(size_t j = 0; j < cube_lits.size(); j++)
+      sat__addClause1(solver,cube_lits[j]);
+    std::vector<int> vars;
+    for(int i = 0; i < n; i++)
+      if(!in_split[i] && !bitset__get(grounded->in,i) && !bitset__get(grounded->out,i))
+        vars.push_back(in_vars[i]);
+    sat__enumerate(solver, vars, [&](){
+      count++;
+      return TRUE;
+    });
+  }else{
+    int next_var = 2*n;
+    std::vector<int> none;
+    std::vector<char> set(n);
+    std::vector<int> clause;
+    while(true){
+      for(size_t j = 0; j < cube_lits.size(); j++)
+        sat__assume(solver,cube_lits[j]);
+      if(sat__solve(solver) != 10)
+        break;
+      for(int i = 0; i < n; i++)
+        set[i] = sat__get(solver,in_vars[i]) > 0;
+      // maximise within the cube, then globally
+      while(extend_admSet(solver,in_vars,aaf,set,cube_lits,++next_var))
+        continue;
+      int preferred = !extend_admSet(solver,in_vars,aaf,set,none,++next_var);
+      if(!preferred){
+        while(extend_admSet(solver,in_vars,aaf,set,none,++next_var))
+          continue;
+        // the preferred extension is in the cube iff it contains exactly
+        // the split arguments of the cube
+        preferred = TRUE;
+        for(size_t j = 0; j < split.size(); j++)
+          if(set[split[j]] != ((cube >> j) & 1))
+            preferred = FALSE;
+      }
+      if(preferred)
+        count++;
+      clause.clear();
+      for(int i = 0; i < n; i++)
+        if(!set[i])
+          clause.push_back(in_vars[i]);
+      if(clause.empty())
+        break;
+      sat__addClause(solver,clause.data(),clause.size());
+    }
+  }
+  free(in_vars);
+  free(out_vars);
+  sat__free(solver);
+  return count;
+}
+
+/**
+ * Counts the complete, stable or preferred extensions (as given by the
+ * track of the task) by cube and conquer with the threads of the task and
+ * prints their number (cf. taas__print_count_bignum()). The split
+ * arguments are the undecided arguments of highest out-degree (their
+ * labels are most likely to decide others), so many as to get about
+ * TAAS_CUBES_PER_THREAD cubes per thread; cubes with a conflict among
+ * the split arguments are skipped. Returns FALSE (without printing
+ * anything) if there is only one thread. Inside taas__solve_parts(), the
+ * task has the share of the threads of its part, so cubes of parts solved
+ * in parallel do not use more threads than given in total.
+ */
+int cube__count(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded){
+  int number_of_threads = task->number_of_threads;
+  if(number_of_threads <= 1)
+    return FALSE;
+  int n = aaf->number_of_arguments;
+  std::vector<int> split;
+  for(int i = 0; i < n; i++)
+    if(!bitset__get(grounded->in,i) && !bitset__get(grounded->out,i))
+      split.push_back(i);
+  std::sort(split.begin(), split.end(), [&](int a, int b){
+    int da = aaf->children_idx[a+1] - aaf->children_idx[a];
+    int db = aaf->children_idx[b+1] - aaf->children_idx[b];
+    return da > db || (da == db && a < b);
+  });
+  int d = 0;
+  while((1L << d) < (long) number_of_threads * TAAS_CUBES_PER_THREAD && d < (int) split.size())
+    d++;
+  split.resize(d);
+  std::vector<long> cubes;
+  for(long cube = 0; cube < (1L << d); cube++){
+    int conflict = FALSE;
+    for(int j = 0; j < d && !conflict; j++){
+      if(!((cube >> j) & 1))
+        continue;
+      for(int k = 0; k < d && !conflict; k++)
+        if(((cube >> k) & 1) && std::binary_search(aaf->children + aaf->children_idx[split[j]], aaf->children + aaf->children_idx[split[j]+1], split[k]))
+          conflict = TRUE;
+    }
+    if(!conflict)
+      cubes.push_back(cube);
+  }
+  const char* semantics = task->track + 3;
+  std::vector<long> counts(cubes.size());
+  std::atomic<int> next(0);
+  taas__parallel(std::min(number_of_threads, (int) cubes.size()), [&](int){
+    for(int i = next++; i < (int) cubes.size(); i = next++)
+      counts[i] = cube__count_cube(aaf, grounded, semantics, split, cubes[i]);
+  });
+  struct BigNum* count = (struct BigNum*) malloc(sizeof(struct BigNum));
+  bignum__init(count, 0);
+  for(size_t i = 0; i < cubes.size(); i++){
+    struct BigNum summand;
+    bignum__init(&summand, counts[i]);
+    bignum__add(count, &summand);
+    free(summand.digits);
+  }
+  taas__print_count_bignum(aaf, count);
+  return TRUE;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -12,6 +12,9 @@
  */
 
 void solve_cepr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded){
+  // if a tolerance is given, the number is estimated (cf. task_ce-approx.cpp)
+  if(approx__requested(task))
+    return approx__count(task, aaf, grounded);
   IpasirSolver solver;
   sat__init(solver, (2*aaf->number_of_arguments)+1);
   // initialise variables
@@ -64,6 +67,10 @@ void solve_cepr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
     if(noFurther)
       break;
     cnt_pr++;
+    // if there are many extensions, they are counted by several threads
+    // instead (cf. task_ce-cube.cpp)
+    if(cnt_pr == TAAS_CUBE_MIN_COUNT && cube__count(task, aaf, grounded))
+      break;
     idx = 0;
     for(int i = 0; i < aaf->number_of_arguments; i++){
         if(!raset__contains(admSet,i)){
@@ -77,9 +84,12 @@ void solve_cepr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
   // set is the only preferred extension
   if(cnt_pr == 0)
     cnt_pr = 1;
-  printf("%i\n",cnt_pr);
+  if(noFurther)
+    taas__print_count(aaf,cnt_pr);
   raset__destroy(admSet);
   raset__destroy(temp);
+  free(in_vars);
+  free(out_vars);
   sat__free(solver);
 }
 
@@ -12,6 +12,9 @@
  */
 
 void solve_cest(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded){
+  // if a tolerance is given, the number is estimated (cf. task_ce-approx.cpp)
+  if(approx__requested(task))
+    return approx__count(task, aaf, grounded);
   IpasirSolver solver;
   sat__init(solver, aaf->number_of_arguments+1);
   // initialise variables
@@ -22,32 +25,26 @@ void solve_cest(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
   }
   // add stability clauses
   add_stbTestClauses(solver,in_vars,aaf,grounded);
-  int stb_cnt = 0;
-  int sat;
-  int clause_idx;
-  int* clause = (int*) malloc(aaf->number_of_arguments * sizeof(int));
-  while(true){
-    // check if there is a stable extension
-    sat = sat__solve(solver);
-    if(sat == 10){
-      stb_cnt++;
-      // add constraint for next iteration
-      clause_idx = 0;
-      for(int i = 0; i < aaf->number_of_arguments; i++){
-        if(sat__get(solver,in_vars[i]) < 0){
-          clause[clause_idx++] = in_vars[i];
-          //printf("X: %s\n", aaf->ids2arguments[i]);
-        }
-      }
-      if(clause_idx == 0)
-        break;
-      else sat__addClause(solver,clause,clause_idx);
-    }else break;
-  }
+  // extensions are determined by their undecided arguments that are in
+  // (the others are decided by the grounded extension), so models are
+  // enumerated projected onto these without blocking clauses
+  std::vector<int> vars;
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    if(!bitset__get(grounded->in,i) && !bitset__get(grounded->out,i))
+      vars.push_back(in_vars[i]);
+  long stb_cnt = 0;
+  int finished = sat__enumerate(solver, vars, [&](){
+    stb_cnt++;
+    // if there are many extensions, AAFs of small treewidth are
+    // counted by dynamic programming and others by several threads
+    // instead (cf. task_ce-cube.cpp)
+    return stb_cnt != TAAS_TREEDEC_MIN_COUNT || !(treedec__count(aaf, grounded, SEM_ST) || cube__count(task, aaf, grounded));
+  });
   // print number of found extensions
-  printf("%i\n", stb_cnt);
-  free(clause);
-  return;
+  if(finished)
+    taas__print_count(aaf,stb_cnt);
+  free(in_vars);
+  sat__free(solver);
 }
 
 /* ============================================================================================================== */
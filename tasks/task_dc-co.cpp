@@ -12,6 +12,10 @@
  */
 
 bool solve_dcco(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded, bool do_print = true){
+  // only the arguments reaching task->arg matter
+  int cone_result = solve_cone(task,aaf,grounded,do_print,solve_dcco);
+  if(cone_result != -1)
+    return cone_result;
   IpasirSolver solver_comTest;
   sat__init(solver_comTest, (2*aaf->number_of_arguments)+1);
   // initialise variables
@@ -26,24 +30,16 @@ bool solve_dcco(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
   add_comTestClauses(solver_comTest,in_vars,out_vars,aaf,grounded);
   // check if there is a complete labelling setting task->arg IN
   sat__assume(solver_comTest,in_vars[task->arg]);
-  int sat = sat__solve(solver_comTest);
-  if(sat == 20){
-      if(do_print)
-        printf("NO\n");
-      return false;
-  }
+  bool accepted = sat__solve(solver_comTest) != 20;
   if(do_print)
-    printf("YES\n");
-  if(PRINT_WITNESS && do_print){
-    printf("w ");
-    for(int i = 0; i < aaf->number_of_arguments; i++){
-      if(sat__get(solver_comTest,in_vars[i]) > 0){
-        printf("%d ",(i+1));
-      }
-    }
-    printf("\n");
+    printf(accepted ? "YES\n" : "NO\n");
+  if(accepted && PRINT_WITNESS && do_print){
+    print_witness(solver_comTest,in_vars,aaf);
   }
-  return true;
+  free(in_vars);
+  free(out_vars);
+  sat__free(solver_comTest);
+  return accepted;
 }
 
 /* ============================================================================================================== */
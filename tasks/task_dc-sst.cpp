@@ -31,13 +31,13 @@ bool solve_dcsst(struct TaskSpecification *task, struct AAF* aaf, struct Labelin
     if(bitset__get(grounded->in,task->arg)){
       if(do_print){
         printf("YES\n");
-        printf("%s\n",taas__lab_print_i23(grounded,aaf));
+        taas__print_witness(aaf,grounded->in);
       }
       return true;
     }else{
       if(do_print){
         printf("NO\n");
-        printf("%s\n",taas__lab_print_i23(grounded,aaf));
+        taas__print_witness(aaf,grounded->in);
       }
       return false;
     }
@@ -91,7 +91,7 @@ bool solve_dcsst(struct TaskSpecification *task, struct AAF* aaf, struct Labelin
               // so we found a semi-stable extension with the argument
               if(do_print){
                 printf("YES\n");
-                raset__print_i23(in_arg,aaf->ids2arguments);
+                raset__print_i23(in_arg,aaf);
               }
               raset__destroy(notUndec);
               raset__destroy(in_arg);
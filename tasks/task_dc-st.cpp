@@ -12,6 +12,19 @@
  */
 
 bool solve_dcst(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded, bool do_print = true){
+  // first try to find a stable extension containing the argument by
+  // processing the components one by one
+  taas__aaf_compute_sccs(aaf);
+  struct BitSet* extension = aaf->number_of_sccs > 1 ? scc__stable(aaf,task->arg,TRUE,task->number_of_threads) : NULL;
+  if(extension != NULL){
+    if(do_print){
+      printf("YES\n");
+      if(PRINT_WITNESS)
+        taas__print_witness(aaf,extension);
+    }
+    bitset__destroy(extension);
+    return true;
+  }
   IpasirSolver solver;
   sat__init(solver, aaf->number_of_arguments+1);
   // initialise variables
@@ -24,24 +37,15 @@ bool solve_dcst(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
   add_stbTestClauses(solver,in_vars,aaf,grounded);
   // check if there is a stable extension containing the argument
   sat__assume(solver,in_vars[task->arg]);
-  int sat = sat__solve(solver);
-  if(sat == 20){
-      if(do_print)
-        printf("NO\n");
-      return false;
-  }
+  bool accepted = sat__solve(solver) != 20;
   if(do_print)
-    printf("YES\n");
-  if(PRINT_WITNESS && do_print){
-    printf("w ");
-    for(int i = 0; i < aaf->number_of_arguments; i++){
-      if(sat__get(solver,in_vars[i]) > 0){
-        printf("%d ",(i+1));
-      }
-    }
-    printf("\n");
+    printf(accepted ? "YES\n" : "NO\n");
+  if(accepted && PRINT_WITNESS && do_print){
+    print_witness(solver,in_vars,aaf);
   }
-  return true;
+  free(in_vars);
+  sat__free(solver);
+  return accepted;
 }
 
 /* ============================================================================================================== */
@@ -0,0 +1,107 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : task_ddnnf.cpp
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : solve function for DC-CO, DC-PR, DC-ST, DS-ST, CE-CO and CE-ST
+               on a decision-DNNF of the encoding of complete resp. stable
+               semantics (cf. taas/taas_ddnnf.c), which is compiled once and
+               stored in a file for later queries
+ ============================================================================
+ */
+
+/**
+ * Returns the d-DNNF of the encoding of the given semantics (SEM_CO or
+ * SEM_ST, cf. add_comTestClauses() and add_stbTestClauses()) for the given
+ * AAF: it is read from the file at the given path if that holds it, and
+ * compiled and written there otherwise. Returns NULL if compilation is
+ * (or has been) given up. The variable of argument i being in is
+ * 2*i+1 for complete and i+1 for stable semantics.
+ */
+struct DDnnf* ddnnf__encoding(struct AAF* aaf, struct Labeling* grounded, int semantics, char* path){
+  uint64_t key = taas__aaf_hash(aaf);
+  struct DDnnf* d = NULL;
+  if(ddnnf__read(path, semantics, key, &d) >= 0)
+    return d;
+  int n = aaf->number_of_arguments;
+  std::vector<int> cnf;
+  IpasirSolver recorder;
+  sat__record(recorder, &cnf);
+  int* in_vars = (int*) malloc(n * sizeof(int));
+  int* out_vars = (int*) malloc(n * sizeof(int));
+  for(int i = 0; i < n; i++){
+    in_vars[i] = semantics == SEM_CO ? 2*i+1 : i+1;
+    out_vars[i] = 2*i+2;
+  }
+  if(semantics == SEM_CO)
+    add_comTestClauses(recorder,in_vars,out_vars,aaf,grounded);
+  else add_stbTestClauses(recorder,in_vars,aaf,grounded);
+  free(in_vars);
+  free(out_vars);
+  d = ddnnf__compile(semantics == SEM_CO ? 2*n : n, cnf);
+  ddnnf__write(path, d, semantics, key);
+  return d;
+}
+
+/**
+ * Solves the given task on the d-DNNF of the encoding of its semantics
+ * (read from or written to the given path, cf. ddnnf__encoding()) and
+ * returns TRUE; returns FALSE if the task is not supported or the
+ * encoding could not be compiled.
+ */
+int solve_ddnnf(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded, char* path){
+  int semantics;
+  if(strcmp(task->track,"DC-CO") == 0 || strcmp(task->track,"DC-PR") == 0 || strcmp(task->track,"CE-CO") == 0)
+    semantics = SEM_CO;
+  else if(strcmp(task->track,"DC-ST") == 0 || strcmp(task->track,"DS-ST") == 0 || strcmp(task->track,"CE-ST") == 0)
+    semantics = SEM_ST;
+  else return FALSE;
+  if(aaf->number_of_arguments == 0)
+    return FALSE;
+  struct DDnnf* d = ddnnf__encoding(aaf, grounded, semantics, path);
+  if(d == NULL)
+    return FALSE;
+  int number_of_variables = d->number_of_variables;
+  signed char* fixed = (signed char*) calloc(number_of_variables+1, sizeof(signed char));
+  if(strncmp(task->track,"CE",2) == 0){
+    struct BigNum* count = (struct BigNum*) malloc(sizeof(struct BigNum));
+    bignum__init(count, 0);
+    ddnnf__count(d, fixed, count);
+    taas__print_count_bignum(aaf, count);
+  }else{
+    // all literals occurring in models are found in one pass
+    char* possible = (char*) malloc(2*number_of_variables+2);
+    ddnnf__literals(d, fixed, possible);
+    int in_var = semantics == SEM_CO ? 2*task->arg+1 : task->arg+1;
+    int credulous = strncmp(task->track,"DC",2) == 0;
+    int accepted = credulous ? possible[ddnnf__index(in_var)] : !possible[ddnnf__index(-in_var)];
+    free(possible);
+    printf(accepted ? "YES\n" : "NO\n");
+    if(PRINT_WITNESS && accepted == credulous){
+      // an extension (not) containing the argument
+      fixed[in_var] = credulous ? 1 : -1;
+      signed char* model = (signed char*) malloc(number_of_variables+1);
+      ddnnf__model(d, fixed, model);
+      struct BitSet* set = (struct BitSet*) malloc(sizeof(struct BitSet));
+      bitset__init(set, aaf->number_of_arguments);
+      bitset__unsetAll(set);
+      for(int i = 0; i < aaf->number_of_arguments; i++)
+        if(model[semantics == SEM_CO ? 2*i+1 : i+1] > 0)
+          bitset__set(set,i);
+      taas__print_witness(aaf,set);
+      bitset__destroy(set);
+      free(model);
+    }
+  }
+  free(fixed);
+  ddnnf__destroy(d);
+  return TRUE;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
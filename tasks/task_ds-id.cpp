@@ -45,9 +45,9 @@ bool solve_dsid(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
         // from the current psc (if there is none we are finished)
         bool emptyclause = true;
         for(int i = 0; i < psc->number_of_elements; i++){
-            for(GSList* node = aaf->parents[psc->elements_arr[i]]; node != NULL; node = node->next){
+            for(int k = aaf->parents_idx[psc->elements_arr[i]]; k < aaf->parents_idx[psc->elements_arr[i]+1]; k++){
                 emptyclause = false;
-                sat__add(solver_admTest, in_vars[*(int*)node->data]);
+                sat__add(solver_admTest, in_vars[aaf->parents[k]]);
             }
         }
         if (emptyclause)
@@ -62,17 +62,17 @@ bool solve_dsid(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
         for(int i = 0; i < aaf->number_of_arguments; i++){
             if(sat__get(solver_admTest,in_vars[i]) > 0){
                 //removing the children from psc
-                for(GSList* node = aaf->children[i]; node != NULL; node = node->next) {
-                    if (raset__contains(psc, *(int*)node->data)){
+                for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++) {
+                    if (raset__contains(psc, aaf->children[k])){
                         // if the argument is actually the argument under consideration we can terminate
-                        if(*(int*)node->data == task->arg){
+                        if(aaf->children[k] == task->arg){
                           if(do_print)
                             printf("NO\n");
                           sat__free(solver_admTest);
                           raset__destroy(psc);
                           return false;
                         }
-                        raset__remove(psc, *(int*)node->data);
+                        raset__remove(psc, aaf->children[k]);
                     }
                 }
             }
@@ -95,68 +95,58 @@ bool solve_dsid(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
       raset__destroy(psc);
       return false;
     }
-    //raset__print(psc,aaf->ids2arguments);
+    //raset__print(psc,aaf);
     // this will hold the ideal extension
     struct RaSet* ideal = raset__init_empty(aaf->number_of_arguments);
+    // the bit-matrix (if it fits into the memory budget) allows checking
+    // attacks and defense word-parallel
+    bitset_word* attacked = NULL;
+    if(taas__aaf_build_matrix(aaf, task->matrix_budget))
+      attacked = (bitset_word*) malloc(aaf->matrix_words * sizeof(bitset_word));
     // only add those arguments to ideal which are not attacked by another argument
     // in psc
     for(int i = 0; i < psc->number_of_elements; i++){
-      bool isAttacked = false;
-      for(GSList* node = aaf->parents[psc->elements_arr[i]]; node != NULL; node = node->next){
-        if(raset__contains(psc, *reinterpret_cast<int*>(node->data))){
-          // if the argument is actually the argument under consideration we can terminate
-          if(psc->elements_arr[i] == task->arg){
-            if(do_print)
-              printf("NO\n");
-            raset__destroy(psc);
-            raset__destroy(ideal);
-            return false;
-          }
-          isAttacked = true;
-          break;
+      if(taas__aaf_is_attacked_by(aaf, psc->elements_arr[i], psc)){
+        // if the argument is actually the argument under consideration we can terminate
+        if(psc->elements_arr[i] == task->arg){
+          if(do_print)
+            printf("NO\n");
+          raset__destroy(psc);
+          raset__destroy(ideal);
+          free(attacked);
+          return false;
         }
+        continue;
       }
-      if(!isAttacked)
-        raset__add(ideal,psc->elements_arr[i]);
+      raset__add(ideal,psc->elements_arr[i]);
     }
-    //raset__print(ideal,aaf->ids2arguments);
+    //raset__print(ideal,aaf);
     // now iterate over ideal and remove arguments not defended by ideal;
     // repeat until no more arguments are removed
     bool changed;
     do{
       changed = false;
+      if(attacked != NULL)
+        taas__aaf_attacked_by(aaf, ideal, attacked);
       for(int i = 0; i < ideal->number_of_elements; i++){
         int arg = ideal->elements_arr[i];
-        bool keep_arg = true;
-        for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next){
-          int attacker = * reinterpret_cast<int*>(node->data);
-          bool found_defender = false;
-          for(GSList* node2 = aaf->parents[attacker]; node2 != NULL; node2 = node2->next){
-            if(raset__contains(ideal,*reinterpret_cast<int*>(node2->data))){
-              found_defender = true;
-              break;
-            }
-          }
-          if(!found_defender){
-            // if the argument is actually the argument under consideration we can terminate
-            if(arg == task->arg){
-              if(do_print)
-                printf("NO\n");
-              raset__destroy(psc);
-              raset__destroy(ideal);
-              return false;
-            }
-            keep_arg = false;
-            break;
+        if(!taas__aaf_is_defended(aaf, arg, ideal, attacked)){
+          // if the argument is actually the argument under consideration we can terminate
+          if(arg == task->arg){
+            if(do_print)
+              printf("NO\n");
+            raset__destroy(psc);
+            raset__destroy(ideal);
+            free(attacked);
+            return false;
           }
-        }
-        if(!keep_arg){
           changed = true;
           raset__remove(ideal,arg);
           i--;
         }
       }
     }while(changed);
+    free(attacked);
     if(do_print)
       printf("YES\n");
     raset__destroy(psc);
@@ -14,6 +14,10 @@
 
 // the fudge approach for DS-PR
 bool solve_dspr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded, bool do_print = true){
+  // only the arguments reaching task->arg matter
+  int cone_result = solve_cone(task,aaf,grounded,do_print,solve_dspr);
+  if(cone_result != -1)
+    return cone_result;
   // solver_admTest is used for checking whether a single set can be extended
   //       to an admissible set
   // solver_attAdmTest is used for checking whether there is an admissible set
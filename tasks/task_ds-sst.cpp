@@ -35,7 +35,7 @@ bool solve_dssst(struct TaskSpecification *task, struct AAF* aaf, struct Labelin
     }else{
       if(do_print){
         printf("NO\n");
-        printf("%s\n",taas__lab_print_i23(grounded,aaf));
+        taas__print_witness(aaf,grounded->in);
       }
       return false;
     }
@@ -89,7 +89,7 @@ bool solve_dssst(struct TaskSpecification *task, struct AAF* aaf, struct Labelin
               // so we found a semi-stable extension without the argument
               if(do_print){
                 printf("NO\n");
-                raset__print_i23(in_arg,aaf->ids2arguments);
+                raset__print_i23(in_arg,aaf);
               }
               raset__destroy(notUndec);
               raset__destroy(in_arg);
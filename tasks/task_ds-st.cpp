@@ -12,6 +12,19 @@
  */
 
 bool solve_dsst(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded, bool do_print = true){
+  // first try to find a stable extension not containing the argument by
+  // processing the components one by one
+  taas__aaf_compute_sccs(aaf);
+  struct BitSet* extension = aaf->number_of_sccs > 1 ? scc__stable(aaf,task->arg,FALSE,task->number_of_threads) : NULL;
+  if(extension != NULL){
+    if(do_print){
+      printf("NO\n");
+      if(PRINT_WITNESS)
+        taas__print_witness(aaf,extension);
+    }
+    bitset__destroy(extension);
+    return false;
+  }
   IpasirSolver solver;
   sat__init(solver, aaf->number_of_arguments+1);
   // initialise variables
@@ -23,59 +36,28 @@ bool solve_dsst(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
   // add stability clauses
   add_stbTestClauses(solver,in_vars,aaf,grounded);
   // first, check whether there is any stable extension
-  int sat = sat__solve(solver);
-  if(sat == 20){
-      // as there is no stable extension, every argument is skeptically accepted
-      if(do_print)
-        printf("YES\n");
-      return true;
-  }
+  // (if there is none, every argument is skeptically accepted)
+  bool accepted = sat__solve(solver) == 20;
   // check whether the argument is in the grounded extension
   // in that case, we are finished
-  if(bitset__get(grounded->in,task->arg)){
-      if(do_print)
-        printf("YES\n");
-      return true;
-  }
-  // check whether the argument attacked by the grounded extension
-  // in that case, we are finished and the above extension
-  // already does not contain the argument
-  if(bitset__get(grounded->out,task->arg)){
-      if(do_print){
-        printf("NO\n");
-        if(PRINT_WITNESS){
-          printf("w ");
-          for(int i = 0; i < aaf->number_of_arguments; i++){
-            if(sat__get(solver,in_vars[i]) > 0){
-              printf("%d ",(i+1));
-            }
-          }
-          printf("\n");
-        }
-      }
-      return false;
-  }
-  // now assume that the argument is out
-  sat__assume(solver,-in_vars[task->arg]);
-  sat = sat__solve(solver);
-  if(sat == 20){
-      if(do_print)
-        printf("YES\n");
-      return true;
+  if(!accepted && bitset__get(grounded->in,task->arg))
+    accepted = true;
+  // unless the argument is attacked by the grounded extension (then
+  // the above extension already does not contain the argument), now
+  // assume that the argument is out
+  else if(!accepted && !bitset__get(grounded->out,task->arg)){
+    sat__assume(solver,-in_vars[task->arg]);
+    accepted = sat__solve(solver) == 20;
   }
   if(do_print){
-    printf("NO\n");
-    if(PRINT_WITNESS){
-      printf("w ");
-      for(int i = 0; i < aaf->number_of_arguments; i++){
-        if(sat__get(solver,in_vars[i]) > 0){
-          printf("%d ",(i+1));
-        }
-      }
-      printf("\n");
+    printf(accepted ? "YES\n" : "NO\n");
+    if(!accepted && PRINT_WITNESS){
+      print_witness(solver,in_vars,aaf);
     }
   }
-  return false;
+  free(in_vars);
+  sat__free(solver);
+  return accepted;
 }
 
 /* ============================================================================================================== */
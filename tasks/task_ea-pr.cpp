@@ -51,9 +51,9 @@ void solve_eapr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
         // from the current psc (if there is none we are finished)
         bool emptyclause = true;
         for(int i = 0; i < psc->number_of_elements; i++){
-            for(GSList* node = aaf->parents[psc->elements_arr[i]]; node != NULL; node = node->next){
+            for(int k = aaf->parents_idx[psc->elements_arr[i]]; k < aaf->parents_idx[psc->elements_arr[i]+1]; k++){
                 emptyclause = false;
-                sat__add(solver_admTest_outer, in_vars[*(int*)node->data]);
+                sat__add(solver_admTest_outer, in_vars[aaf->parents[k]]);
             }
         }
         if (emptyclause)
@@ -68,9 +68,9 @@ void solve_eapr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
         for(int i = 0; i < aaf->number_of_arguments; i++){
             if(sat__get(solver_admTest_outer,in_vars[i]) > 0){
                 //removing the children from psc
-                for(GSList* node = aaf->children[i]; node != NULL; node = node->next) {
-                    if (raset__contains(psc, *(int*)node->data))
-                        raset__remove(psc, *(int*)node->data);
+                for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++) {
+                    if (raset__contains(psc, aaf->children[k]))
+                        raset__remove(psc, aaf->children[k]);
                 }
             }
         }
@@ -91,62 +91,45 @@ void solve_eapr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
     // now compute the maximal admissible set in psc
     // if no argument is in the psc, there are no accepted arguments
     if(psc->number_of_elements == 0){
-      raset__print(psc,aaf->ids2arguments);
+      raset__print(psc,aaf);
       raset__destroy(psc);
       return;
     }
-    //raset__print(psc,aaf->ids2arguments);
+    //raset__print(psc,aaf);
     // this will hold the the set of acceptable arguments
     struct RaSet* acc = raset__init_empty(aaf->number_of_arguments);
+    // the bit-matrix (if it fits into the memory budget) allows checking
+    // attacks and defense word-parallel
+    bitset_word* attacked = NULL;
+    if(taas__aaf_build_matrix(aaf, task->matrix_budget))
+      attacked = (bitset_word*) malloc(aaf->matrix_words * sizeof(bitset_word));
     // only add those arguments to acc which are not attacked by another argument
     // in psc
     for(int i = 0; i < psc->number_of_elements; i++){
-      bool isAttacked = false;
-      for(GSList* node = aaf->parents[psc->elements_arr[i]]; node != NULL; node = node->next){
-        if(raset__contains(psc, *reinterpret_cast<int*>(node->data))){
-          isAttacked = true;
-          break;
-        }
-      }
-      if(!isAttacked)
+      if(!taas__aaf_is_attacked_by(aaf, psc->elements_arr[i], psc))
         raset__add(acc,psc->elements_arr[i]);
     }
-    //raset__print(acc,aaf->ids2arguments);
+    //raset__print(acc,aaf);
     // now iterate over acc and remove arguments not defended by acc;
     // repeat until no more arguments are removed
     bool changed;
     do{
       changed = false;
+      if(attacked != NULL)
+        taas__aaf_attacked_by(aaf, acc, attacked);
       for(int i = 0; i < acc->number_of_elements; i++){
         int arg = acc->elements_arr[i];
-        //printf("A: %s\n", aaf->ids2arguments[arg]);
-        bool keep_arg = true;
-        for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next){
-          int attacker = * reinterpret_cast<int*>(node->data);
-          //printf("B: %s\n", aaf->ids2arguments[attacker]);
-          bool found_defender = false;
-          for(GSList* node2 = aaf->parents[attacker]; node2 != NULL; node2 = node2->next){
-            //printf("C: %s\n", aaf->ids2arguments[*reinterpret_cast<int*>(node2->data)]);
-            if(raset__contains(acc,*reinterpret_cast<int*>(node2->data))){
-              found_defender = true;
-              break;
-            }
-          }
-          if(!found_defender){
-            keep_arg = false;
-            break;
-          }
-        }
-        if(!keep_arg){
+        if(!taas__aaf_is_defended(aaf, arg, acc, attacked)){
           changed = true;
           raset__remove(acc,arg);
-          //printf("D: ");raset__print(ideal,aaf->ids2arguments);
+          //printf("D: ");raset__print(ideal,aaf);
           i--;
         }
       }
     }while(changed);
+    free(attacked);
     // acc now holds the ideal extension
-    //raset__print(acc,aaf->ids2arguments);
+    //raset__print(acc,aaf);
     // now compute the strong preferred super core by removing all arguments
     // from psc\acc that are not contained in an admissible set
     // add admissibility clauses
@@ -179,7 +162,7 @@ void solve_eapr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
     }
     sat__free(solver_admTest2);
     //now spsc contains the elements in the strong preferred super core that are not already in acc
-    //raset__print(spsc,aaf->ids2arguments);
+    //raset__print(spsc,aaf);
     // test all arguments in spsc
     for(int i = 0; i < spsc->number_of_elements; i++){
       int arg = spsc->elements_arr[i];
@@ -237,7 +220,7 @@ void solve_eapr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
           sat__add(solver_attAdmTest,0);
       }
     }
-    raset__print(acc,aaf->ids2arguments);
+    raset__print(acc,aaf);
     raset__destroy(acc);
     raset__destroy(psc);
     return;
@@ -16,6 +16,7 @@
 // or attacked by it
 bool add_admTestClauses(IpasirSolver & solver, int* in_vars, int* out_vars, struct AAF* aaf, struct Labeling* grounded){
    bool all_grounded = true;
+   int* out_clause = (int*) malloc((2+aaf->number_of_arguments) * sizeof(int));
    for(int i = 0; i < aaf->number_of_arguments; i++){
        // argument i cannot both be in and out
        sat__addClause2(solver,-in_vars[i],-out_vars[i]);
@@ -30,17 +31,16 @@ bool add_admTestClauses(IpasirSolver & solver, int* in_vars, int* out_vars, stru
        all_grounded = false;
        // if argument is IN then all attackers must be OUT
        // if argument is OUT then some attacker must be IN
-       int* out_clause = (int*) malloc((2+aaf->number_of_arguments) * sizeof(int));
        int idx = 1;
        out_clause[0] = -out_vars[i];
-       for(GSList* node = aaf->parents[i]; node != NULL; node = node->next){
-           sat__addClause2(solver,-in_vars[i],out_vars[(*(int*)node->data)]);
-           out_clause[idx++] = in_vars[*(int*)node->data];
+       for(int k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++){
+           sat__addClause2(solver,-in_vars[i],out_vars[aaf->parents[k]]);
+           out_clause[idx++] = in_vars[aaf->parents[k]];
        }
        out_clause[idx] = 0;
        sat__addClauseZT(solver,out_clause);
-       free(out_clause);
    }
+   free(out_clause);
    return all_grounded;
 }
 
@@ -49,6 +49,7 @@ bool add_admTestClauses(IpasirSolver & solver, int* in_vars, int* out_vars, stru
 // or attacked by it
 bool add_cfTestClauses(IpasirSolver & solver, int* in_vars, int* out_vars, struct AAF* aaf, struct Labeling* grounded){
    bool all_grounded = true;
+   int* out_clause = (int*) malloc((2+aaf->number_of_arguments) * sizeof(int));
    for(int i = 0; i < aaf->number_of_arguments; i++){
        // argument i cannot both be in and out
        sat__addClause2(solver,-in_vars[i],-out_vars[i]);
@@ -56,17 +57,16 @@ bool add_cfTestClauses(IpasirSolver & solver, int* in_vars, int* out_vars, struc
        if(!bitset__get(grounded->in,i) && !bitset__get(grounded->out,i))
             all_grounded = false;
        // add conflict-free clauses
-       int* out_clause = (int*) malloc((2+aaf->number_of_arguments) * sizeof(int));
        int idx = 1;
        out_clause[0] = -out_vars[i];
-       for(GSList* node = aaf->parents[i]; node != NULL; node = node->next){
-           sat__addClause2(solver,-in_vars[(*(int*)node->data)],out_vars[i]);
-           out_clause[idx++] = in_vars[*(int*)node->data];
+       for(int k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++){
+           sat__addClause2(solver,-in_vars[aaf->parents[k]],out_vars[i]);
+           out_clause[idx++] = in_vars[aaf->parents[k]];
        }
        out_clause[idx] = 0;
        sat__addClauseZT(solver,out_clause);
-       free(out_clause);
    }
+   free(out_clause);
    return all_grounded;
 }
 
@@ -76,12 +76,12 @@ void add_attackClauses(IpasirSolver & solver, int* in_vars, int* in_attacked_var
     int idx_attack = 0;
     int idx = attack_idx_offset;
     for(int i = 0; i < aaf->number_of_arguments; i++){
-      for(GSList* node = aaf->parents[i]; node != NULL; node = node->next){
+      for(int k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++){
         clause_oneattack[idx_attack++] = idx;
         // the following three formulas model "attack_var <=> (in_attacker && in_attacked)"
-        sat__addClause2(solver,-idx,in_vars[*(int*)node->data]);
+        sat__addClause2(solver,-idx,in_vars[aaf->parents[k]]);
         sat__addClause2(solver,-idx,in_attacked_vars[i]);
-        sat__addClause3(solver,idx,-in_attacked_vars[i],-in_vars[*(int*)node->data]);
+        sat__addClause3(solver,idx,-in_attacked_vars[i],-in_vars[aaf->parents[k]]);
         idx++;
       }
     }
@@ -102,9 +102,9 @@ void add_stbTestClauses(IpasirSolver & solver, int* in_vars, struct AAF* aaf, st
       int idx = 1;
       clause[0] = in_vars[i];
       char emptyclause = TRUE;
-      for(GSList* node = aaf->parents[i]; node != NULL; node = node->next){
-        sat__addClause2(solver,-in_vars[i],-in_vars[(*(int*)node->data)]);
-        clause[idx++] = in_vars[*(int*)node->data];
+      for(int k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++){
+        sat__addClause2(solver,-in_vars[i],-in_vars[aaf->parents[k]]);
+        clause[idx++] = in_vars[aaf->parents[k]];
         emptyclause = FALSE;
      }
      if (!emptyclause){
@@ -136,11 +136,11 @@ void add_comTestClauses(IpasirSolver & solver, int* in_vars, int* out_vars, stru
       clause[0] = -out_vars[i];
       clause2[0] = in_vars[i];
       // missing: if all parents out then argument in
-      for(GSList* node = aaf->parents[i]; node != NULL; node = node->next){
-          sat__addClause2(solver,-in_vars[i],out_vars[(*(int*)node->data)]);
-          sat__addClause2(solver,-in_vars[(*(int*)node->data)],out_vars[i]);
-          clause[idx++] = in_vars[(*(int*)node->data)];
-          clause2[idx2++] = -out_vars[(*(int*)node->data)];
+      for(int k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++){
+          sat__addClause2(solver,-in_vars[i],out_vars[aaf->parents[k]]);
+          sat__addClause2(solver,-in_vars[aaf->parents[k]],out_vars[i]);
+          clause[idx++] = in_vars[aaf->parents[k]];
+          clause2[idx2++] = -out_vars[aaf->parents[k]];
       }
       sat__addClause(solver,clause,idx);
       sat__addClause(solver,clause2,idx2);
@@ -149,6 +149,64 @@ void add_comTestClauses(IpasirSolver & solver, int* in_vars, int* out_vars, stru
   free(clause2);
 }
 
+// decides the query of the task with the given solve function on the backward
+// cone of the queried argument (cf. taas__aaf_cone()); only to be used for
+// semantics satisfying directionality. Returns the result of solve, or -1
+// if the cone contains all arguments.
+int solve_cone(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded, bool do_print,
+        bool (*solve)(struct TaskSpecification*, struct AAF*, struct Labeling*, bool)){
+  struct AAF* cone = taas__aaf_cone(aaf,grounded,task->arg);
+  if(cone == NULL)
+    return -1;
+  struct Labeling* cone_grounded = taas__lab_reduct(grounded,cone);
+  int arg = task->arg;
+  task->arg = taas__aaf_reduct_find(cone,arg);
+  bool result = solve(task,cone,cone_grounded,do_print);
+  task->arg = arg;
+  taas__lab_destroy(cone_grounded);
+  taas__aaf_destroy(cone);
+  return result;
+}
+
+// prints the arguments set to in by the current model of the solver as a
+// witness (cf. taas__print_witness())
+void print_witness(IpasirSolver & solver, int* in_vars, struct AAF* aaf){
+  struct BitSet* set = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(set, aaf->number_of_arguments);
+  bitset__unsetAll(set);
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    if(sat__get(solver,in_vars[i]) > 0)
+      bitset__set(set,i);
+  taas__print_witness(aaf,set);
+  bitset__destroy(set);
+}
+
+// adds the clause "ext implies that some argument not in the given set is
+// in" and returns true iff the solver finds a model with ext, the arguments
+// in the set being in, and the given assumptions; then the arguments that
+// are in in the model are added to the set. ext (a fresh variable) is
+// retired afterwards.
+bool extend_admSet(IpasirSolver & solver, int* in_vars, struct AAF* aaf, std::vector<char>& set, std::vector<int>& assumptions, int ext){
+  std::vector<int> clause;
+  clause.push_back(-ext);
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    if(!set[i])
+      clause.push_back(in_vars[i]);
+  sat__addClause(solver,clause.data(),clause.size());
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    if(set[i])
+      sat__assume(solver,in_vars[i]);
+  for(size_t i = 0; i < assumptions.size(); i++)
+    sat__assume(solver,assumptions[i]);
+  sat__assume(solver,ext);
+  bool found = sat__solve(solver) == 10;
+  if(found)
+    for(int i = 0; i < aaf->number_of_arguments; i++)
+      set[i] = set[i] || sat__get(solver,in_vars[i]) > 0;
+  sat__addClause1(solver,-ext);
+  return found;
+}
+
  /** prints the model of the given Glucose solver */
 /*
  void printModel(Glucose::Solver* solver, int* in_vars, struct AAF* aaf){
@@ -160,7 +218,7 @@ void add_comTestClauses(IpasirSolver & solver, int* in_vars, int* out_vars, stru
       if(isFirst)
         isFirst = false;
       else printf(",");
-      printf("%s", aaf->ids2arguments[i]);
+      printf("%s", taas__aaf_argument_name(aaf,i));
     }
     printf("}\n");
  }
@@ -0,0 +1,497 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : task_scc.cpp
+ Author      : Matthias Thimm
+ Version     : 1.1
+ Copyright   : GPL3
+ Description : SCC-recursive computation of preferred and stable extensions:
+               the strongly connected components are processed in
+               topological order, where each component is solved by a small
+               SAT call (or exhaustively, cf. taas/taas_tiny.c) on the
+               arguments of the component that are not attacked by the
+               extension built so far. Results of components are memoised
+               by their canonical forms (cf. taas/taas_memo.c), so that
+               isomorphic components are solved only once. With several
+               threads, components are processed as soon as all their
+               upstream components are (cf. util/scheduler.c).
+ ============================================================================
+ */
+
+/** Frameworks with fewer arguments are processed by a single thread */
+#define TAAS_PARALLEL_SCC_MIN_ARGUMENTS (1 << 14)
+
+/** Flags of remaining arguments that have to be in resp. must not be in */
+#define SCC_REQUIRED 1
+#define SCC_FORBIDDEN 2
+
+/**
+ * The state of an SCC-recursive computation: the extension built so far
+ * and the arguments attacked by it (all components processed so far are
+ * labelled completely by these two sets). If components are processed in
+ * parallel, each worker has its own state sharing in, out and local.
+ */
+struct SccState{
+  struct AAF* aaf;
+  struct BitSet* in;
+  struct BitSet* out;
+  // the arguments of the current component that are not out
+  int* remaining;
+  int number_of_remaining;
+  // for each argument of the current component, 1 + its index in
+  // remaining (0 if not remaining); only valid for the current component
+  int* local;
+  // the memo of results of components (NULL if there is none)
+  struct SccMemo* memo;
+};
+
+void scc__init(struct SccState* state, struct AAF* aaf){
+  int n = aaf->number_of_arguments;
+  taas__aaf_compute_sccs(aaf);
+  state->aaf = aaf;
+  state->in = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(state->in, n);
+  bitset__unsetAll(state->in);
+  state->out = (struct BitSet*) malloc(sizeof(struct BitSet));
+  bitset__init(state->out, n);
+  bitset__unsetAll(state->out);
+  int largest = 0;
+  for(int c = 0; c < aaf->number_of_sccs; c++)
+    largest = std::max(largest, aaf->scc_idx[c+1] - aaf->scc_idx[c]);
+  state->remaining = (int*) malloc((largest+1) * sizeof(int));
+  state->local = (int*) calloc(n+1, sizeof(int));
+  state->memo = taas__aaf_scc_memo(aaf);
+}
+
+void scc__destroy(struct SccState* state){
+  bitset__destroy(state->out);
+  free(state->remaining);
+  free(state->local);
+}
+
+/** Collects the arguments of component c that are not attacked by the extension */
+void scc__begin_component(struct SccState* state, int c){
+  struct AAF* aaf = state->aaf;
+  state->number_of_remaining = 0;
+  for(int k = aaf->scc_idx[c]; k < aaf->scc_idx[c+1]; k++){
+    int arg = aaf->scc_members[k];
+    if(bitset__get_atomic(state->out,arg))
+      continue;
+    state->remaining[state->number_of_remaining++] = arg;
+    state->local[arg] = state->number_of_remaining;
+  }
+}
+
+/**
+ * Adds the given argument to the extension and marks its children as out
+ * (atomically, as other workers may set bits in the same words)
+ */
+void scc__add(struct SccState* state, int arg){
+  struct AAF* aaf = state->aaf;
+  bitset__test_and_set_atomic(state->in,arg);
+  for(int k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+    bitset__test_and_set_atomic(state->out,aaf->children[k]);
+}
+
+void scc__end_component(struct SccState* state){
+  for(int i = 0; i < state->number_of_remaining; i++)
+    state->local[state->remaining[i]] = 0;
+}
+
+/**
+ * Initialises the given tiny AAF with the remaining arguments of the
+ * current component (at most 64, argument i is remaining[i]) and the
+ * attacks between them.
+ */
+void scc__tiny(struct SccState* state, struct TinyAAF* t){
+  struct AAF* aaf = state->aaf;
+  tiny__init(t, state->number_of_remaining);
+  for(int i = 0; i < state->number_of_remaining; i++){
+    int a = state->remaining[i];
+    for(int k = aaf->parents_idx[a]; k < aaf->parents_idx[a+1]; k++){
+      int p = aaf->scc[aaf->parents[k]] == aaf->scc[a] ? state->local[aaf->parents[k]] : 0;
+      if(p != 0)
+        tiny__add_attack(t, p-1, i);
+    }
+  }
+}
+
+/** Adds the given set of remaining arguments (cf. scc__tiny()) to the extension */
+void scc__add_tiny(struct SccState* state, uint64_t set){
+  for(; set != 0; set &= set - 1)
+    scc__add(state, state->remaining[__builtin_ctzll(set)]);
+}
+
+/**
+ * Solves the current component with solve(), which extends the extension
+ * by a set of remaining arguments (respecting the given flags, cf.
+ * SCC_REQUIRED) and returns whether it has found one, unless the memo has
+ * a result for a component isomorphic to it (where kind distinguishes the
+ * problems solved). Then this set is added directly, otherwise the set
+ * found is stored in the memo.
+ */
+template<typename F> int scc__memoised(struct SccState* state, int kind, char* flags, F solve){
+  struct AAF* aaf = state->aaf;
+  int r = state->number_of_remaining;
+  if(state->memo == NULL || r < TAAS_MEMO_MIN_ARGUMENTS || r > TAAS_MEMO_MAX_ARGUMENTS)
+    return solve();
+  // the attacks between remaining arguments (argument i is remaining[i])
+  int* children_idx = (int*) malloc((r+1) * sizeof(int));
+  std::vector<int> children;
+  for(int i = 0; i < r; i++){
+    int a = state->remaining[i];
+    children_idx[i] = children.size();
+    for(int k = aaf->children_idx[a]; k < aaf->children_idx[a+1]; k++){
+      int c = aaf->scc[aaf->children[k]] == aaf->scc[a] ? state->local[aaf->children[k]] : 0;
+      if(c != 0)
+        children.push_back(c-1);
+    }
+  }
+  children_idx[r] = children.size();
+  int* order = (int*) malloc((r+1) * sizeof(int));
+  std::vector<int> key, result;
+  uint64_t hash = memo__canonical(r, children_idx, children.data(), flags, kind, order, key);
+  int found;
+  if(memo__lookup(state->memo, hash, key, result)){
+    found = result[0];
+    for(size_t k = 1; k < result.size(); k++)
+      scc__add(state, state->remaining[order[result[k]]]);
+  }else{
+    found = solve();
+    result.assign(1, found);
+    for(int p = 0; p < r; p++)
+      if(bitset__get_atomic(state->in, state->remaining[order[p]]))
+        result.push_back(p);
+    memo__store(state->memo, hash, key, result);
+  }
+  free(children_idx);
+  free(order);
+  return found;
+}
+
+/**
+ * Initialises the given tiny AAF with the remaining arguments of the
+ * current component (cf. scc__tiny()) restricted by the given flags.
+ */
+void scc__tiny_flags(struct SccState* state, char* flags, struct TinyAAF* t){
+  scc__tiny(state, t);
+  for(int i = 0; i < state->number_of_remaining; i++)
+    if(flags[i] == SCC_REQUIRED)
+      t->required |= TINY_BIT(i);
+    else if(flags[i] == SCC_FORBIDDEN)
+      t->forbidden |= TINY_BIT(i);
+}
+
+/**
+ * Tries to extend the extension by a stable extension of the (at most 64)
+ * remaining arguments of the current component that respects the given
+ * flags exhaustively. Returns FALSE if this takes too long; otherwise
+ * found is set to whether there is such a stable extension.
+ */
+int scc__tiny_stable(struct SccState* state, char* flags, int* found){
+  struct TinyAAF t;
+  scc__tiny_flags(state, flags, &t);
+  uint64_t extension = 0;
+  *found = FALSE;
+  long budget = TAAS_TINY_BUDGET;
+  if(!tiny__enumerate(&t, SEM_ST, &budget, [&](uint64_t set){
+        extension = set;
+        *found = TRUE;
+        return FALSE;
+      }))
+    return FALSE;
+  scc__add_tiny(state, extension);
+  return TRUE;
+}
+
+/**
+ * Extends the extension by a stable extension of the remaining arguments of
+ * the current component that respects the given flags (by a SAT call).
+ * Returns FALSE if there is no such stable extension.
+ */
+int scc__sat_stable(struct SccState* state, char* flags){
+  struct AAF* aaf = state->aaf;
+  int r = state->number_of_remaining;
+  IpasirSolver solver;
+  sat__init(solver, r);
+  int* clause = (int*) malloc((r+1) * sizeof(int));
+  for(int i = 0; i < r; i++){
+    int a = state->remaining[i];
+    // argument i is in or attacked by a remaining argument that is in
+    int idx = 0;
+    clause[idx++] = i+1;
+    for(int k = aaf->parents_idx[a]; k < aaf->parents_idx[a+1]; k++){
+      int p = aaf->scc[aaf->parents[k]] == aaf->scc[a] ? state->local[aaf->parents[k]] : 0;
+      if(p == 0)
+        continue;
+      sat__addClause2(solver,-(i+1),-p);
+      clause[idx++] = p;
+    }
+    sat__addClause(solver,clause,idx);
+    if(flags[i] == SCC_REQUIRED)
+      sat__addClause1(solver,i+1);
+    else if(flags[i] == SCC_FORBIDDEN)
+      sat__addClause1(solver,-(i+1));
+  }
+  free(clause);
+  int sat = sat__solve(solver);
+  if(sat == 10)
+    for(int i = 0; i < r; i++)
+      if(sat__get(solver,i+1) > 0)
+        scc__add(state,state->remaining[i]);
+  sat__free(solver);
+  return sat == 10;
+}
+
+/**
+ * Extends the extension by a stable extension of the remaining arguments of
+ * the current component. If arg is remaining, it is in (if arg_in is TRUE)
+ * or out (otherwise). Returns FALSE if there is no such stable extension.
+ */
+int scc__stable_component(struct SccState* state, int arg, int arg_in){
+  struct AAF* aaf = state->aaf;
+  int r = state->number_of_remaining;
+  // a single argument has to be in if it is not self-attacking
+  if(r == 1){
+    int a = state->remaining[0];
+    if(bitset__get(aaf->loops,a) || (a == arg && !arg_in))
+      return FALSE;
+    scc__add(state,a);
+    return TRUE;
+  }
+  char* flags = (char*) calloc(r+1, 1);
+  if(arg != -1 && state->local[arg] != 0)
+    flags[state->local[arg]-1] = arg_in ? SCC_REQUIRED : SCC_FORBIDDEN;
+  // small components are solved exhaustively (unless this takes too long),
+  // which is cheaper than looking them up in the memo
+  int found;
+  if(r > TAAS_TINY_MAX_ARGUMENTS || !scc__tiny_stable(state, flags, &found))
+    found = scc__memoised(state, SEM_ST, flags, [&](){
+      return scc__sat_stable(state, flags);
+    });
+  free(flags);
+  return found;
+}
+
+/**
+ * Tries to extend the extension by a maximal set of the (at most 64)
+ * remaining arguments of the current component that is admissible wrt.
+ * the remaining arguments and respects the given flags exhaustively.
+ * Returns FALSE if this takes too long.
+ */
+int scc__tiny_preferred(struct SccState* state, char* flags){
+  struct TinyAAF t;
+  scc__tiny_flags(state, flags, &t);
+  // replacing the current set by any strict superset ends with a maximal one
+  uint64_t current = 0;
+  long budget = TAAS_TINY_BUDGET;
+  if(!tiny__enumerate(&t, SEM_ADM, &budget, [&](uint64_t set){
+        if((set & current) == current)
+          current = set;
+        return TRUE;
+      }))
+    return FALSE;
+  scc__add_tiny(state, current);
+  return TRUE;
+}
+
+/**
+ * Extends the extension by a maximal set of remaining arguments of the
+ * current component that is admissible wrt. the remaining arguments and
+ * respects the given flags (by a sequence of SAT calls).
+ */
+void scc__sat_preferred(struct SccState* state, char* flags){
+  struct AAF* aaf = state->aaf;
+  int r = state->number_of_remaining;
+  // variables 2i+1 (in) and 2i+2 (attacked by the set) for argument i
+  IpasirSolver solver;
+  sat__init(solver, 2*r);
+  int* clause = (int*) malloc((r+2) * sizeof(int));
+  for(int i = 0; i < r; i++){
+    int a = state->remaining[i];
+    sat__addClause2(solver,-(2*i+1),-(2*i+2));
+    int idx = 0;
+    clause[idx++] = -(2*i+2);
+    for(int k = aaf->parents_idx[a]; k < aaf->parents_idx[a+1]; k++){
+      int p = aaf->scc[aaf->parents[k]] == aaf->scc[a] ? state->local[aaf->parents[k]] : 0;
+      if(p == 0)
+        continue;
+      sat__addClause2(solver,-(2*i+1),2*p);
+      clause[idx++] = 2*p-1;
+    }
+    sat__addClause(solver,clause,idx);
+    if(flags[i] == SCC_FORBIDDEN)
+      sat__addClause1(solver,-(2*i+1));
+    else if(flags[i] == SCC_REQUIRED)
+      sat__addClause1(solver,2*i+1);
+  }
+  // the current set is extended until it is maximal
+  char* current = (char*) calloc(r+1, 1);
+  while(sat__solve(solver) == 10){
+    // read the model first, as adding clauses invalidates it
+    for(int i = 0; i < r; i++)
+      if(sat__get(solver,2*i+1) > 0)
+        current[i] = TRUE;
+    int idx = 0;
+    for(int i = 0; i < r; i++){
+      if(current[i])
+        sat__addClause1(solver,2*i+1);
+      else if(flags[i] != SCC_FORBIDDEN)
+        clause[idx++] = 2*i+1;
+    }
+    if(idx == 0)
+      break;
+    sat__addClause(solver,clause,idx);
+  }
+  for(int i = 0; i < r; i++)
+    if(current[i])
+      scc__add(state,state->remaining[i]);
+  free(current);
+  free(clause);
+  sat__free(solver);
+}
+
+/**
+ * Extends the extension by a maximal set of remaining arguments of the
+ * current component that is admissible wrt. the remaining arguments, that
+ * contains the arguments of initial (if not NULL) in the component, and
+ * that contains no argument attacked by an undecided argument of an
+ * earlier component (such attacks cannot be defended against).
+ */
+void scc__preferred_component(struct SccState* state, struct RaSet* initial){
+  struct AAF* aaf = state->aaf;
+  int r = state->number_of_remaining;
+  // arguments that cannot be defended against attackers from earlier
+  // components are forbidden
+  char* flags = (char*) calloc(r+1, 1);
+  for(int i = 0; i < r; i++){
+    int a = state->remaining[i];
+    for(int k = aaf->parents_idx[a]; k < aaf->parents_idx[a+1]; k++)
+      if(aaf->scc[aaf->parents[k]] != aaf->scc[a] && !bitset__get_atomic(state->out,aaf->parents[k]))
+        flags[i] = SCC_FORBIDDEN;
+    if(flags[i] != SCC_FORBIDDEN && initial != NULL && raset__contains(initial,a))
+      flags[i] = SCC_REQUIRED;
+  }
+  if(r == 1){
+    if(flags[0] != SCC_FORBIDDEN && !bitset__get(aaf->loops,state->remaining[0]))
+      scc__add(state,state->remaining[0]);
+  }else if(r > TAAS_TINY_MAX_ARGUMENTS || !scc__tiny_preferred(state, flags))
+    scc__memoised(state, SEM_ADM, flags, [&](){
+      scc__sat_preferred(state, flags);
+      return TRUE;
+    });
+  free(flags);
+}
+
+/**
+ * Processes the components of the AAF of the given state in topological
+ * order with solve(state,c), which returns FALSE if the computation has
+ * failed (then no further components are processed). With several threads,
+ * each component becomes a task that is released once all its upstream
+ * components are processed. Returns FALSE iff the computation has failed.
+ */
+template<typename F> int scc__process(struct SccState* state, int number_of_threads, F solve){
+  struct AAF* aaf = state->aaf;
+  if(number_of_threads > aaf->number_of_sccs)
+    number_of_threads = aaf->number_of_sccs;
+  if(number_of_threads <= 1 || aaf->number_of_arguments < TAAS_PARALLEL_SCC_MIN_ARGUMENTS){
+    for(int c = 0; c < aaf->number_of_sccs; c++){
+      scc__begin_component(state, c);
+      int success = solve(state, c);
+      scc__end_component(state);
+      if(!success)
+        return FALSE;
+    }
+    return TRUE;
+  }
+  // the number of attacks from upstream components that are not processed yet
+  int* pending = (int*) calloc(aaf->number_of_sccs+1, sizeof(int));
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      if(aaf->scc[aaf->children[k]] != aaf->scc[i])
+        pending[aaf->scc[aaf->children[k]]]++;
+  int* initial = (int*) malloc((aaf->number_of_sccs+1) * sizeof(int));
+  int number_of_initial = 0;
+  for(int c = 0; c < aaf->number_of_sccs; c++)
+    if(pending[c] == 0)
+      initial[number_of_initial++] = c;
+  // each worker has its own buffer for the remaining arguments
+  std::vector<struct SccState> workers(number_of_threads, *state);
+  for(int w = 1; w < number_of_threads; w++)
+    workers[w].remaining = (int*) malloc((aaf->number_of_arguments+1) * sizeof(int));
+  workers[0].remaining = state->remaining;
+  std::atomic<int> failed(FALSE);
+  taas__parallel_tasks(initial, number_of_initial, number_of_threads, [&](struct TaskScheduler* scheduler, int c, int w){
+    if(failed.load(std::memory_order_relaxed))
+      return;
+    scc__begin_component(&workers[w], c);
+    int success = solve(&workers[w], c);
+    scc__end_component(&workers[w]);
+    if(!success){
+      failed.store(TRUE);
+      return;
+    }
+    for(int k = aaf->scc_idx[c]; k < aaf->scc_idx[c+1]; k++){
+      int a = aaf->scc_members[k];
+      for(int k2 = aaf->children_idx[a]; k2 < aaf->children_idx[a+1]; k2++){
+        int d = aaf->scc[aaf->children[k2]];
+        if(d != c && __atomic_sub_fetch(&pending[d], 1, __ATOMIC_ACQ_REL) == 0)
+          taas__scheduler_release(scheduler, w, d);
+      }
+    }
+  });
+  for(int w = 1; w < number_of_threads; w++)
+    free(workers[w].remaining);
+  free(pending);
+  free(initial);
+  return !failed.load();
+}
+
+/**
+ * Tries to compute a stable extension of the given AAF component by
+ * component, where arg (if not -1) is in (if arg_in is TRUE) or not
+ * (otherwise). As the stable extensions of a component depend on the choice
+ * made for earlier components, this may fail even if there is such an
+ * extension; in that case NULL is returned.
+ */
+struct BitSet* scc__stable(struct AAF* aaf, int arg, int arg_in, int number_of_threads){
+  struct SccState state;
+  scc__init(&state, aaf);
+  int success = scc__process(&state, number_of_threads, [&](struct SccState* s, int c){
+    if(arg != -1 && arg_in && aaf->scc[arg] == c && s->local[arg] == 0)
+      return FALSE;
+    if(s->number_of_remaining == 0)
+      return TRUE;
+    return scc__stable_component(s, arg, arg_in);
+  });
+  scc__destroy(&state);
+  if(!success){
+    bitset__destroy(state.in);
+    return NULL;
+  }
+  // self-check (only if compiled without NDEBUG)
+  assert(taas__check_extension(aaf,state.in,SEM_ST));
+  return state.in;
+}
+
+/**
+ * Computes a preferred extension of the given AAF (containing the given
+ * admissible set, if not NULL) component by component.
+ */
+struct BitSet* scc__preferred(struct AAF* aaf, struct RaSet* initial, int number_of_threads){
+  struct SccState state;
+  scc__init(&state, aaf);
+  scc__process(&state, number_of_threads, [&](struct SccState* s, int c){
+    if(s->number_of_remaining > 0)
+      scc__preferred_component(s, initial);
+    return TRUE;
+  });
+  scc__destroy(&state);
+  return state.in;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
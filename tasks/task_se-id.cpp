@@ -44,9 +44,9 @@ struct RaSet* compute_ideal(struct TaskSpecification *task, struct AAF* aaf, str
         // from the current psc (if there is none we are finished)
         bool emptyclause = true;
         for(int i = 0; i < psc->number_of_elements; i++){
-            for(GSList* node = aaf->parents[psc->elements_arr[i]]; node != NULL; node = node->next){
+            for(int k = aaf->parents_idx[psc->elements_arr[i]]; k < aaf->parents_idx[psc->elements_arr[i]+1]; k++){
                 emptyclause = false;
-                sat__add(solver_admTest, in_vars[*(int*)node->data]);
+                sat__add(solver_admTest, in_vars[aaf->parents[k]]);
             }
         }
         if (emptyclause)
@@ -61,9 +61,9 @@ struct RaSet* compute_ideal(struct TaskSpecification *task, struct AAF* aaf, str
         for(int i = 0; i < aaf->number_of_arguments; i++){
             if(sat__get(solver_admTest,in_vars[i]) > 0){
                 //removing the children from psc
-                for(GSList* node = aaf->children[i]; node != NULL; node = node->next) {
-                    if (raset__contains(psc, *(int*)node->data))
-                        raset__remove(psc, *(int*)node->data);
+                for(int k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++) {
+                    if (raset__contains(psc, aaf->children[k]))
+                        raset__remove(psc, aaf->children[k]);
                 }
             }
         }
@@ -84,59 +84,47 @@ struct RaSet* compute_ideal(struct TaskSpecification *task, struct AAF* aaf, str
     if(psc->number_of_elements == 0){
       return psc;
     }
-    //raset__print(psc,aaf->ids2arguments);
+    //raset__print(psc,aaf);
     // this will hold the ideal extension
     struct RaSet* ideal = raset__init_empty(aaf->number_of_arguments);
+    // the bit-matrix (if it fits into the memory budget) allows checking
+    // attacks and defense word-parallel
+    bitset_word* attacked = NULL;
+    if(taas__aaf_build_matrix(aaf, task->matrix_budget))
+      attacked = (bitset_word*) malloc(aaf->matrix_words * sizeof(bitset_word));
     // only add those arguments to ideal which are not attacked by another argument
     // in psc
     for(int i = 0; i < psc->number_of_elements; i++){
-      bool isAttacked = false;
-      for(GSList* node = aaf->parents[psc->elements_arr[i]]; node != NULL; node = node->next){
-        if(raset__contains(psc, *reinterpret_cast<int*>(node->data))){
-          isAttacked = true;
-          break;
-        }
-      }
-      if(!isAttacked)
+      if(!taas__aaf_is_attacked_by(aaf, psc->elements_arr[i], psc))
         raset__add(ideal,psc->elements_arr[i]);
     }
-    //raset__print(ideal,aaf->ids2arguments);
+    //raset__print(ideal,aaf);
     // now iterate over ideal and remove arguments not defended by ideal;
     // repeat until no more arguments are removed
     bool changed;
     do{
       changed = false;
+      if(attacked != NULL)
+        taas__aaf_attacked_by(aaf, ideal, attacked);
       for(int i = 0; i < ideal->number_of_elements; i++){
         int arg = ideal->elements_arr[i];
-        bool keep_arg = true;
-        for(GSList* node = aaf->parents[arg]; node != NULL; node = node->next){
-          int attacker = * reinterpret_cast<int*>(node->data);
-          bool found_defender = false;
-          for(GSList* node2 = aaf->parents[attacker]; node2 != NULL; node2 = node2->next){
-            if(raset__contains(ideal,*reinterpret_cast<int*>(node2->data))){
-              found_defender = true;
-              break;
-            }
-          }
-          if(!found_defender){
-            keep_arg = false;
-            break;
-          }
-        }
-        if(!keep_arg){
+        if(!taas__aaf_is_defended(aaf, arg, ideal, attacked)){
           changed = true;
           raset__remove(ideal,arg);
           i--;
         }
       }
     }while(changed);
+    free(attacked);
     raset__destroy(psc);
     return ideal;
 }
 
 void solve_seid(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded){
   struct RaSet* ideal = compute_ideal(task,aaf,grounded);
-  raset__print_i23(ideal,aaf->ids2arguments);
+  // self-check (only if compiled without NDEBUG)
+  assert(taas__check_extension(aaf,ideal->elements,SEM_ADM));
+  raset__print_i23(ideal,aaf);
   raset__destroy(ideal);
 }
 
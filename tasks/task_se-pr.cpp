@@ -13,6 +13,30 @@
 
 // the fudge approach for SE-PR
 void solve_sepr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded, struct RaSet* initial_admSet = NULL){
+  // if called for a witness on a cone (cf. taas__aaf_cone()), the witness
+  // has to be a preferred extension of the original AAF
+  if(aaf->origin != NULL && aaf->origin_cone){
+    struct RaSet* origin_admSet = NULL;
+    if(initial_admSet != NULL){
+      origin_admSet = raset__init_empty(aaf->origin->number_of_arguments);
+      for(int i = 0; i < initial_admSet->number_of_elements; i++)
+        raset__add(origin_admSet,aaf->origin_ids[initial_admSet->elements_arr[i]]);
+      raset__destroy(initial_admSet);
+    }
+    return solve_sepr(task,aaf->origin,aaf->origin_grounded,origin_admSet);
+  }
+  // if there are several components, they are processed one by one
+  taas__aaf_compute_sccs(aaf);
+  if(aaf->number_of_sccs > 1){
+    struct BitSet* extension = scc__preferred(aaf,initial_admSet,task->number_of_threads);
+    // self-check (only if compiled without NDEBUG)
+    assert(taas__check_extension(aaf,extension,SEM_CO));
+    taas__print_witness(aaf,extension);
+    bitset__destroy(extension);
+    if(initial_admSet != NULL)
+      raset__destroy(initial_admSet);
+    return;
+  }
   IpasirSolver solver;
   sat__init(solver, 2*aaf->number_of_arguments);
   // initialise variables
@@ -29,7 +53,7 @@ void solve_sepr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
   // is also preferred
   if(all_grounded){
     sat__free(solver);
-    printf("%s\n",taas__lab_print_i23(grounded,aaf));
+    taas__print_witness(aaf,grounded->in);
     return;
   }
   // add a clause imposing that at least one argument is in the set
@@ -74,7 +98,9 @@ void solve_sepr(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
       raset__reset(temp);
   }
   free(clause);
-  raset__print_i23(admSet,aaf->ids2arguments);
+  // self-check (only if compiled without NDEBUG)
+  assert(taas__check_extension(aaf,admSet->elements,SEM_CO));
+  raset__print_i23(admSet,aaf);
   raset__destroy(admSet);
   raset__destroy(temp);
   sat__free(solver);
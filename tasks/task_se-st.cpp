@@ -12,6 +12,14 @@
  */
 
 void solve_sest(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded){
+  // first try to process the components one by one
+  taas__aaf_compute_sccs(aaf);
+  struct BitSet* extension = aaf->number_of_sccs > 1 ? scc__stable(aaf,-1,FALSE,task->number_of_threads) : NULL;
+  if(extension != NULL){
+    taas__print_witness(aaf,extension);
+    bitset__destroy(extension);
+    return;
+  }
   IpasirSolver solver;
   sat__init(solver, aaf->number_of_arguments+1);
   // initialise variables
@@ -24,18 +32,11 @@ void solve_sest(struct TaskSpecification *task, struct AAF* aaf, struct Labeling
   add_stbTestClauses(solver,in_vars,aaf,grounded);
   // check if there is a stable extension
   int sat = sat__solve(solver);
-  if(sat == 20){
-      printf("NO\n");
-      return;
-  }
-  // print extension
-  printf("w ");
-  for(int i = 0; i < aaf->number_of_arguments; i++){
-    if(sat__get(solver,in_vars[i]) > 0)
-      printf("%s ",aaf->ids2arguments[i]);
-  }
-  printf("\n");
-  return;
+  if(sat == 20)
+    taas__print_no_extension(aaf);
+  else print_witness(solver,in_vars,aaf);
+  free(in_vars);
+  sat__free(solver);
 }
 
 /* ============================================================================================================== */
@@ -29,7 +29,7 @@ void solve_sestg(struct TaskSpecification *task, struct AAF* aaf, struct Labelin
   // is also stage
   if(all_grounded){
     sat__free(solver);
-    printf("%s\n",taas__lab_print_i23(grounded,aaf));
+    taas__print_witness(aaf,grounded->in);
     return;
   }
   // add a clause imposing that at least one argument is not undecided
@@ -70,7 +70,7 @@ void solve_sestg(struct TaskSpecification *task, struct AAF* aaf, struct Labelin
       raset__reset(temp);
   }
   free(clause);
-  raset__print_i23(in_arg,aaf->ids2arguments);
+  raset__print_i23(in_arg,aaf);
   raset__destroy(notUndec);
   raset__destroy(in_arg);
   raset__destroy(temp);
@@ -0,0 +1,148 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : bignum.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Arbitrary-precision non-negative integers (e.g. for numbers
+               of extensions, which are products over components).
+ ============================================================================
+ */
+
+#define BIGNUM_BASE 1000000000
+
+/**
+ * A non-negative integer in base 10^9 (so that it can be printed digit by
+ * digit); digits[0] is the least significant digit and digits[size-1] is
+ * non-zero (size is 0 for zero).
+ */
+struct BigNum{
+  int size;
+  /** The number of digits allocated */
+  int capacity;
+  uint32_t* digits;
+};
+
+/** Initialises the given number with the given value */
+void bignum__init(struct BigNum* num, unsigned long value){
+  // an unsigned long has at most 20 decimal digits
+  num->digits = (uint32_t*) malloc(3 * sizeof(uint32_t));
+  num->capacity = 3;
+  num->size = 0;
+  while(value > 0){
+    num->digits[num->size++] = (uint32_t) (value % BIGNUM_BASE);
+    value /= BIGNUM_BASE;
+  }
+}
+
+/** Destroys the given number */
+void bignum__destroy(struct BigNum* num){
+  free(num->digits);
+  free(num);
+}
+
+/** Returns TRUE iff the given number is zero */
+int bignum__is_zero(struct BigNum* num){
+  return num->size == 0;
+}
+
+/** Multiplies num by other (other may be num) */
+void bignum__mul(struct BigNum* num, struct BigNum* other){
+  int size = num->size + other->size;
+  uint32_t* digits = (uint32_t*) calloc(size+1, sizeof(uint32_t));
+  for(int i = 0; i < num->size; i++){
+    uint64_t carry = 0;
+    for(int j = 0; j < other->size; j++){
+      // at most (10^9-1) + (10^9-1)^2 + (10^9-1) < 2^64
+      uint64_t t = digits[i+j] + (uint64_t) num->digits[i] * other->digits[j] + carry;
+      digits[i+j] = (uint32_t) (t % BIGNUM_BASE);
+      carry = t / BIGNUM_BASE;
+    }
+    digits[i+other->size] = (uint32_t) carry;
+  }
+  while(size > 0 && digits[size-1] == 0)
+    size--;
+  free(num->digits);
+  num->digits = digits;
+  num->capacity = num->size + other->size + 1;
+  num->size = size;
+}
+
+/** Multiplies num by the given value */
+void bignum__mul_ulong(struct BigNum* num, unsigned long value){
+  struct BigNum factor;
+  bignum__init(&factor, value);
+  bignum__mul(num, &factor);
+  free(factor.digits);
+}
+
+/** Makes sure that the given number can hold the given number of digits */
+void bignum__reserve(struct BigNum* num, int capacity){
+  if(capacity <= num->capacity)
+    return;
+  num->digits = (uint32_t*) realloc(num->digits, capacity * sizeof(uint32_t));
+  num->capacity = capacity;
+}
+
+/** Sets num to the given value */
+void bignum__set_ulong(struct BigNum* num, unsigned long value){
+  bignum__reserve(num, 3);
+  num->size = 0;
+  while(value > 0){
+    num->digits[num->size++] = (uint32_t) (value % BIGNUM_BASE);
+    value /= BIGNUM_BASE;
+  }
+}
+
+/** Sets num to the value of other */
+void bignum__set(struct BigNum* num, struct BigNum* other){
+  bignum__reserve(num, other->size);
+  memcpy(num->digits, other->digits, other->size * sizeof(uint32_t));
+  num->size = other->size;
+}
+
+/** Adds other to num (other may be num) */
+void bignum__add(struct BigNum* num, struct BigNum* other){
+  int size = std::max(num->size, other->size);
+  bignum__reserve(num, size+1);
+  uint32_t carry = 0;
+  for(int i = 0; i < size; i++){
+    uint32_t t = (i < num->size ? num->digits[i] : 0) + (i < other->size ? other->digits[i] : 0) + carry;
+    carry = t >= BIGNUM_BASE;
+    num->digits[i] = carry ? t - BIGNUM_BASE : t;
+  }
+  num->digits[size] = carry;
+  num->size = size + carry;
+}
+
+/** Subtracts other from num, where other must not be larger than num */
+void bignum__sub(struct BigNum* num, struct BigNum* other){
+  int borrow = 0;
+  for(int i = 0; i < num->size; i++){
+    int64_t t = (int64_t) num->digits[i] - (i < other->size ? other->digits[i] : 0) - borrow;
+    borrow = t < 0;
+    num->digits[i] = (uint32_t) (borrow ? t + BIGNUM_BASE : t);
+  }
+  // self-check (only if compiled without NDEBUG)
+  assert(borrow == 0);
+  while(num->size > 0 && num->digits[num->size-1] == 0)
+    num->size--;
+}
+
+/** Prints the given number (in decimal) */
+void bignum__print(struct BigNum* num){
+  if(num->size == 0){
+    printf("0");
+    return;
+  }
+  printf("%u", num->digits[num->size-1]);
+  for(int i = num->size-2; i >= 0; i--)
+    printf("%09u", num->digits[i]);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -10,21 +10,23 @@
  Description : A simple bitset implementation.
  ============================================================================
  */
-#define WORD_BITS (8 * sizeof(unsigned int))
+/* The type of the words of a bit set */
+typedef uint64_t bitset_word;
+#define WORD_BITS (8 * sizeof(bitset_word))
 
 /* A bit set structure */
 struct BitSet{
-	unsigned int* data;
+	bitset_word* data;
 	// number of bits
 	int length;
-	// number of ints
+	// number of words
 	int num_elements;
 };
 
 /** Init bit set. */
 void bitset__init(struct BitSet* bitset, int length){
 	bitset->num_elements = ((length/WORD_BITS)+1);
-	bitset->data = (unsigned int*) malloc(bitset->num_elements * sizeof(unsigned int));
+	bitset->data = (bitset_word*) malloc(bitset->num_elements * sizeof(bitset_word));
   bitset->length = length;
 }
 
@@ -33,67 +35,150 @@ void bitset__init(struct BitSet* bitset, int length){
  */
 void bitset__randomize(struct BitSet* bitset){
 	for(int i = 0; i < bitset->num_elements; i++)
-		bitset->data[i] = rand();
+		bitset->data[i] = ((bitset_word) rand() << 40) ^ ((bitset_word) rand() << 20) ^ (bitset_word) rand();
 }
 
 /** Clones the first bitset */
 void bitset__clone(struct BitSet* bitset1, struct BitSet* bitset2){
 	bitset2->num_elements = bitset1->num_elements;
 	bitset2->length = bitset1->length;
-	bitset2->data = (unsigned int*) malloc(bitset2->num_elements * sizeof(unsigned int));
-	memcpy(bitset2->data,bitset1->data,bitset2->num_elements*sizeof(unsigned int));
+	bitset2->data = (bitset_word*) malloc(bitset2->num_elements * sizeof(bitset_word));
+	memcpy(bitset2->data,bitset1->data,bitset2->num_elements*sizeof(bitset_word));
 }
 
 /** set a value in a bitset **/
 void bitset__set(struct BitSet* bitset, size_t idx) {
-	bitset->data[idx / WORD_BITS] |= (1 << (idx % WORD_BITS));
+	bitset->data[idx / WORD_BITS] |= ((bitset_word) 1 << (idx % WORD_BITS));
 }
 
 /** sets all bits */
 void bitset__setAll(struct BitSet* bitset){
-	memset(bitset->data, ~0, bitset->num_elements * sizeof(unsigned int));
+	memset(bitset->data, ~0, bitset->num_elements * sizeof(bitset_word));
+}
+
+/**
+ * Atomically sets a value in a bitset (so that several threads may set
+ * bits in the same bitset); returns TRUE iff the bit was not set before.
+ */
+int bitset__test_and_set_atomic(struct BitSet* bitset, size_t idx) {
+	bitset_word mask = ((bitset_word) 1 << (idx % WORD_BITS));
+	return (__atomic_fetch_or(&bitset->data[idx / WORD_BITS], mask, __ATOMIC_RELAXED) & mask) == 0;
+}
+
+/** Atomically reads a value of a bitset (cf. bitset__test_and_set_atomic()) */
+int bitset__get_atomic(struct BitSet* bitset, size_t idx){
+	return (__atomic_load_n(&bitset->data[idx / WORD_BITS], __ATOMIC_RELAXED) >> (idx % WORD_BITS)) & 1;
 }
 
 /** unset a value in a bitset **/
 void bitset__unset(struct BitSet* bitset, size_t idx) {
-	bitset->data[idx / WORD_BITS] &= ~(1 << (idx % WORD_BITS));
+	bitset->data[idx / WORD_BITS] &= ~((bitset_word) 1 << (idx % WORD_BITS));
 }
 
 /** unsets all bits */
 void bitset__unsetAll(struct BitSet* bitset){
-	memset(bitset->data, 0, bitset->num_elements * sizeof(unsigned int));
+	memset(bitset->data, 0, bitset->num_elements * sizeof(bitset_word));
 }
 
-/** get value of bit in bitset **/
+/** get value of bit in bitset (1 if set, 0 otherwise) **/
 int bitset__get(struct BitSet* bitset, size_t idx){
-	return ((bitset->data[idx / WORD_BITS]) & (1<<(idx % WORD_BITS)));
+	return (bitset->data[idx / WORD_BITS] >> (idx % WORD_BITS)) & 1;
 }
 
 /** Returns the index of the next set bit starting from given idx (it may
  * return idx itself), or -1 if no more set bit found. */
 int bitset__next_set_bit(struct BitSet* bitset, int idx){
-	//TODO make this more efficient?
-	int i,j;
+	if(idx >= bitset->length)
+		return -1;
 	int elem = idx/WORD_BITS;
-	if(bitset->data[elem] != 0){
-		for(j = idx; bitset__get(bitset,j) == 0 && j < (elem+1)*WORD_BITS && j < bitset->length; j++ );
-		if(j >= bitset->length) return -1;
-		if(j < (elem+1)*WORD_BITS){
-			return j;
-		}
+	// ignore the bits before idx in the first word
+	bitset_word word = bitset->data[elem] & (~(bitset_word) 0 << (idx % WORD_BITS));
+	while(word == 0){
+		if(++elem >= bitset->num_elements)
+			return -1;
+		word = bitset->data[elem];
 	}
-	if(elem+1 >= bitset->num_elements) return -1;
-	for(i = elem+1; i < bitset->num_elements && bitset->data[i] ==0; i++);
-	if(i >= bitset->num_elements) return -1;
-	for(j = i * WORD_BITS; bitset__get(bitset,j) == 0 && j < bitset->length; j++ );
-	if(j >= bitset->length) return -1;
-	return j;
+	int j = elem * WORD_BITS + __builtin_ctzll(word);
+	return j < bitset->length ? j : -1;
+}
+
+/** Returns the mask of the valid bits of the last word of a bitset */
+inline bitset_word bitset__last_word_mask(struct BitSet* bitset){
+	return ((bitset_word) 1 << (bitset->length % WORD_BITS)) - 1;
+}
+
+/** Returns the number of set bits */
+int bitset__count(struct BitSet* bitset){
+	int count = 0;
+	for(int i = 0; i < bitset->num_elements - 1; i++)
+		count += __builtin_popcountll(bitset->data[i]);
+	return count + __builtin_popcountll(bitset->data[bitset->num_elements-1] & bitset__last_word_mask(bitset));
+}
+
+/*
+ * Bulk operations on bitsets of the same length; the first bitset is
+ * modified in place (the loops work a word at a time and are vectorised
+ * by the compiler).
+ */
+
+/** bitset1 := bitset1 AND bitset2 */
+void bitset__and(struct BitSet* bitset1, struct BitSet* bitset2){
+	bitset_word* __restrict d1 = bitset1->data;
+	const bitset_word* __restrict d2 = bitset2->data;
+	for(int i = 0; i < bitset1->num_elements; i++)
+		d1[i] &= d2[i];
+}
+
+/** bitset1 := bitset1 OR bitset2 */
+void bitset__or(struct BitSet* bitset1, struct BitSet* bitset2){
+	bitset_word* __restrict d1 = bitset1->data;
+	const bitset_word* __restrict d2 = bitset2->data;
+	for(int i = 0; i < bitset1->num_elements; i++)
+		d1[i] |= d2[i];
+}
+
+/** bitset1 := bitset1 AND NOT bitset2 */
+void bitset__andnot(struct BitSet* bitset1, struct BitSet* bitset2){
+	bitset_word* __restrict d1 = bitset1->data;
+	const bitset_word* __restrict d2 = bitset2->data;
+	for(int i = 0; i < bitset1->num_elements; i++)
+		d1[i] &= ~d2[i];
+}
+
+/** Returns TRUE iff both bitsets contain the same bits */
+int bitset__equals(struct BitSet* bitset1, struct BitSet* bitset2){
+	bitset_word diff = 0;
+	int last = bitset1->num_elements - 1;
+	for(int i = 0; i < last; i++)
+		diff |= bitset1->data[i] ^ bitset2->data[i];
+	diff |= (bitset1->data[last] ^ bitset2->data[last]) & bitset__last_word_mask(bitset1);
+	return diff == 0;
+}
+
+/** Returns TRUE iff every bit of bitset1 is also set in bitset2 */
+int bitset__is_subset(struct BitSet* bitset1, struct BitSet* bitset2){
+	bitset_word diff = 0;
+	int last = bitset1->num_elements - 1;
+	for(int i = 0; i < last; i++)
+		diff |= bitset1->data[i] & ~bitset2->data[i];
+	diff |= (bitset1->data[last] & ~bitset2->data[last]) & bitset__last_word_mask(bitset1);
+	return diff == 0;
+}
+
+/** Returns TRUE iff the bitsets have a common set bit */
+int bitset__intersects(struct BitSet* bitset1, struct BitSet* bitset2){
+	bitset_word common = 0;
+	int last = bitset1->num_elements - 1;
+	for(int i = 0; i < last; i++)
+		common |= bitset1->data[i] & bitset2->data[i];
+	common |= (bitset1->data[last] & bitset2->data[last]) & bitset__last_word_mask(bitset1);
+	return common != 0;
 }
 
 /** resizes the bit set */
 void bitset__resize(struct BitSet* bitset, int new_length, int value){
 	bitset->num_elements = ((new_length/WORD_BITS)+1);
-	bitset->data = (unsigned int*) realloc(bitset->data, bitset->num_elements * sizeof(unsigned int));
+	bitset->data = (bitset_word*) realloc(bitset->data, bitset->num_elements * sizeof(bitset_word));
 	int old_length = bitset->length;
 	bitset->length = new_length;
 	// set values to default value
@@ -33,6 +33,41 @@ char *trimwhitespace(char *str){
   *(end+1) = 0;
   return str;
 }
+
+/**
+ * Runs func(t) for t=0,...,number_of_tasks-1, each in its own thread
+ * (or directly if there is only one task).
+ */
+template<typename F> void taas__parallel(int number_of_tasks, F func){
+  if(number_of_tasks <= 1){
+    if(number_of_tasks == 1)
+      func(0);
+    return;
+  }
+  std::vector<std::thread> threads;
+  for(int t = 0; t < number_of_tasks; t++)
+    threads.push_back(std::thread(func, t));
+  for(size_t t = 0; t < threads.size(); t++)
+    threads[t].join();
+}
+
+/**
+ * Splits [begin,end) into number_of_threads contiguous ranges and runs
+ * func(lo,hi) on each range in its own thread.
+ */
+template<typename F> void taas__parallel_for(int begin, int end, int number_of_threads, F func){
+  if(number_of_threads > end - begin)
+    number_of_threads = end - begin;
+  if(number_of_threads <= 1){
+    if(begin < end)
+      func(begin, end);
+    return;
+  }
+  taas__parallel(number_of_threads, [&](int t){
+    func(begin + (int)((long)(end - begin) * t / number_of_threads),
+         begin + (int)((long)(end - begin) * (t+1) / number_of_threads));
+  });
+}
 /* ============================================================================================================== */
 /* == END FILE ================================================================================================== */
 /* ============================================================================================================== */
@@ -102,25 +102,26 @@ int raset__get(struct RaSet* set, int idx){
   return set->elements_arr[idx];
 }
 
-// prints the set using the given map to strings
-void raset__print(struct RaSet* set, char** ids2arguments){
+struct AAF;
+const char* taas__aaf_argument_name(struct AAF* aaf, int arg);
+void taas__print_witness(struct AAF* aaf, struct BitSet* set);
+
+// prints the set using the argument names of the given AAF
+void raset__print(struct RaSet* set, struct AAF* aaf){
   printf("[");
   char isFirst = TRUE;
   for(int i = 0; i < set->number_of_elements; i++){
     if(isFirst)
       isFirst = FALSE;
     else printf(",");
-    printf("%s", ids2arguments[set->elements_arr[i]]);
+    printf("%s", taas__aaf_argument_name(aaf,set->elements_arr[i]));
   }
   printf("]\n");
 }
 
-// prints the set using the given map to strings in ICCMA23 style
-void raset__print_i23(struct RaSet* set, char** ids2arguments){
-  printf("w ");
-  for(int i = 0; i < set->number_of_elements; i++)
-    printf("%s ", ids2arguments[set->elements_arr[i]]);
-  printf("\n");
+// prints the set as a witness in ICCMA23 style (cf. taas__print_witness())
+void raset__print_i23(struct RaSet* set, struct AAF* aaf){
+  taas__print_witness(aaf,set->elements);
 }
 
 // frees the set
@@ -0,0 +1,174 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : scheduler.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : A work-stealing task scheduler: each worker thread has its own
+               deque of ready tasks (Chase-Lev deque, the owner works at the
+               bottom, other workers steal lock-free from the top), and tasks
+               may release further tasks while running.
+ ============================================================================
+ */
+
+#define WORK_EMPTY -1
+#define WORK_ABORT -2
+
+/** A circular array of tasks (cf. struct WorkDeque) */
+struct WorkArray{
+  long size;
+  std::atomic<int>* tasks;
+};
+
+/**
+ * A Chase-Lev deque of tasks (non-negative ints). Only the owner pushes
+ * and takes (at the bottom), other threads steal (at the top). When the
+ * array is full, it is replaced by one of twice the size; old arrays are
+ * kept until the deque is destroyed, as thieves may still read them.
+ */
+struct WorkDeque{
+  std::atomic<long> top;
+  std::atomic<long> bottom;
+  std::atomic<struct WorkArray*> array;
+  std::vector<struct WorkArray*> arrays;
+};
+
+struct WorkArray* workarray__init(long size){
+  struct WorkArray* array = (struct WorkArray*) malloc(sizeof(struct WorkArray));
+  array->size = size;
+  array->tasks = new std::atomic<int>[size];
+  return array;
+}
+
+void workdeque__init(struct WorkDeque* deque){
+  deque->top.store(0);
+  deque->bottom.store(0);
+  deque->arrays.push_back(workarray__init(64));
+  deque->array.store(deque->arrays.back());
+}
+
+void workdeque__destroy(struct WorkDeque* deque){
+  for(size_t i = 0; i < deque->arrays.size(); i++){
+    delete[] deque->arrays[i]->tasks;
+    free(deque->arrays[i]);
+  }
+  deque->arrays.clear();
+}
+
+/** Pushes a task at the bottom (owner only) */
+void workdeque__push(struct WorkDeque* deque, int task){
+  long b = deque->bottom.load(std::memory_order_relaxed);
+  long t = deque->top.load(std::memory_order_acquire);
+  struct WorkArray* array = deque->array.load(std::memory_order_relaxed);
+  if(b - t > array->size - 1){
+    struct WorkArray* bigger = workarray__init(2 * array->size);
+    for(long i = t; i < b; i++)
+      bigger->tasks[i % bigger->size].store(array->tasks[i % array->size].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    deque->arrays.push_back(bigger);
+    deque->array.store(bigger, std::memory_order_release);
+    array = bigger;
+  }
+  array->tasks[b % array->size].store(task, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  deque->bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+/** Takes a task from the bottom (owner only); returns WORK_EMPTY if there is none */
+int workdeque__take(struct WorkDeque* deque){
+  long b = deque->bottom.load(std::memory_order_relaxed) - 1;
+  struct WorkArray* array = deque->array.load(std::memory_order_relaxed);
+  deque->bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  long t = deque->top.load(std::memory_order_relaxed);
+  if(t > b){
+    deque->bottom.store(b + 1, std::memory_order_relaxed);
+    return WORK_EMPTY;
+  }
+  int task = array->tasks[b % array->size].load(std::memory_order_relaxed);
+  if(t == b){
+    // last task, compete with thieves
+    if(!deque->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      task = WORK_EMPTY;
+    deque->bottom.store(b + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+/**
+ * Steals a task from the top (any thread); returns WORK_EMPTY if there is
+ * none and WORK_ABORT if another thread interfered.
+ */
+int workdeque__steal(struct WorkDeque* deque){
+  long t = deque->top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  long b = deque->bottom.load(std::memory_order_acquire);
+  if(t >= b)
+    return WORK_EMPTY;
+  struct WorkArray* array = deque->array.load(std::memory_order_acquire);
+  int task = array->tasks[t % array->size].load(std::memory_order_relaxed);
+  if(!deque->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    return WORK_ABORT;
+  return task;
+}
+
+/** The state of taas__parallel_tasks() */
+struct TaskScheduler{
+  int number_of_threads;
+  // the deque of each worker
+  std::vector<struct WorkDeque> deques;
+  // the number of tasks that are ready or running
+  std::atomic<long> outstanding;
+};
+
+/** Makes the given task ready; to be called by a running task of the given worker */
+void taas__scheduler_release(struct TaskScheduler* scheduler, int worker, int task){
+  scheduler->outstanding.fetch_add(1, std::memory_order_relaxed);
+  workdeque__push(&scheduler->deques[worker], task);
+}
+
+/**
+ * Runs func(scheduler, task, worker) for all given initial tasks and all
+ * tasks released while running (cf. taas__scheduler_release()), using
+ * number_of_threads workers. Released tasks are pushed to the deque of the
+ * current worker, and idle workers steal from the others. Returns when no
+ * task is ready or running any more.
+ */
+template<typename F> void taas__parallel_tasks(int* initial, int number_of_initial, int number_of_threads, F func){
+  struct TaskScheduler scheduler;
+  scheduler.number_of_threads = number_of_threads;
+  scheduler.deques = std::vector<struct WorkDeque>(number_of_threads);
+  for(int w = 0; w < number_of_threads; w++)
+    workdeque__init(&scheduler.deques[w]);
+  // initial tasks are distributed round-robin
+  for(int i = 0; i < number_of_initial; i++)
+    workdeque__push(&scheduler.deques[i % number_of_threads], initial[i]);
+  scheduler.outstanding.store(number_of_initial);
+  taas__parallel(number_of_threads, [&](int worker){
+    int victim = worker;
+    while(scheduler.outstanding.load(std::memory_order_acquire) > 0){
+      int task = workdeque__take(&scheduler.deques[worker]);
+      // try to steal from every other worker once
+      for(int i = 1; i < number_of_threads && task < 0; i++){
+        victim = (victim + 1) % number_of_threads;
+        if(victim == worker)
+          victim = (victim + 1) % number_of_threads;
+        task = workdeque__steal(&scheduler.deques[victim]);
+      }
+      if(task < 0){
+        std::this_thread::yield();
+        continue;
+      }
+      func(&scheduler, task, worker);
+      scheduler.outstanding.fetch_sub(1, std::memory_order_acq_rel);
+    }
+  });
+  for(int w = 0; w < number_of_threads; w++)
+    workdeque__destroy(&scheduler.deques[w]);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */